@@ -0,0 +1,147 @@
+/*
+ * adc0.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// ADC0 SS0, triggered by Timer 0A
+// Internal temperature sensor
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "adc0.h"
+
+#define ADC_CTL_DITHER          0x00000040
+#define SYSTEM_CLOCK            40000000
+
+// Flags of a step in SSCTL0, one nibble per step
+#define STEP_END                0x2
+#define STEP_IE                 0x4
+#define STEP_TS                 0x8
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Results of the last completed sequence, one per step
+uint16_t adcSamples[ADC0_MAX_INPUTS];
+uint8_t adcSteps = 0;
+// Completed sequences, lets a reader tell a new set from the last one
+uint32_t adcSequence = 0;
+_adcFn adcCallback = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Samples the inputs in order on every Timer 0A time-out, so the CPU only
+// sees the interrupt at the end of the sequence
+bool initAdc0(const uint8_t inputs[], uint8_t count, uint32_t rateHz)
+{
+    uint32_t mux = 0, control = 0;
+    uint8_t i;
+    if (count == 0 || count > ADC0_MAX_INPUTS || rateHz == 0 || rateHz > SYSTEM_CLOCK)
+        return false;
+
+    // Enable clocks
+    SYSCTL_RCGCADC_R |= SYSCTL_RCGCADC_R0;
+    SYSCTL_RCGCTIMER_R |= SYSCTL_RCGCTIMER_R0;
+    _delay_cycles(16);
+
+    for (i = 0; i < count; i++)
+    {
+        if (inputs[i] == ADC0_INPUT_TS)
+            control |= (uint32_t)STEP_TS << (i * 4);
+        else
+            mux |= (uint32_t)(inputs[i] & 0xF) << (i * 4);
+    }
+    control |= (uint32_t)(STEP_END | STEP_IE) << ((count - 1) * 4);
+    adcSteps = count;
+
+    // Configure ADC
+    ADC0_ACTSS_R &= ~ADC_ACTSS_ASEN0;                // disable sample sequencer 0 (SS0) for programming
+    ADC0_CC_R = ADC_CC_CS_SYSPLL;                    // select PLL as the time base (not needed, since default value)
+    ADC0_PC_R = ADC_PC_SR_1M;                        // select 1Msps rate
+    ADC0_EMUX_R = (ADC0_EMUX_R & ~ADC_EMUX_EM0_M) | ADC_EMUX_EM0_TIMER;
+    ADC0_SSMUX0_R = mux;
+    ADC0_SSCTL0_R = control;
+    ADC0_ISC_R = ADC_ISC_IN0;
+    ADC0_IM_R |= ADC_IM_MASK0;                       // interrupt at the end of the sequence
+    NVIC_EN0_R |= 1 << (INT_ADC0SS0 - 16);           // turn-on interrupt 30 (ADC0 SS0)
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0;                 // enable SS0 for operation
+
+    // Timer 0A only starts the sequence, it has no interrupt of its own
+    TIMER0_CTL_R &= ~TIMER_CTL_TAEN;
+    TIMER0_CFG_R = TIMER_CFG_32_BIT_TIMER;
+    TIMER0_TAMR_R = TIMER_TAMR_TAMR_PERIOD;
+    TIMER0_TAILR_R = SYSTEM_CLOCK / rateHz - 1;
+    TIMER0_CTL_R |= TIMER_CTL_TAOTE | TIMER_CTL_TAEN;
+    return true;
+}
+
+// Set SS0 input sample average count, each step then takes 2^N conversions
+void setAdc0Log2AverageCount(uint8_t log2AverageCount)
+{
+    ADC0_ACTSS_R &= ~ADC_ACTSS_ASEN0;                // disable sample sequencer 0 (SS0) for programming
+    ADC0_SAC_R = log2AverageCount;                   // sample HW averaging
+    if (log2AverageCount == 0)
+        ADC0_CTL_R &= ~ADC_CTL_DITHER;               // turn-off dithering if no averaging
+    else
+        ADC0_CTL_R |= ADC_CTL_DITHER;                // turn-on dithering if averaging
+    ADC0_ACTSS_R |= ADC_ACTSS_ASEN0;                 // enable SS0 for operation
+}
+
+// Called from the interrupt once a sequence is in adcSamples
+void setAdc0Callback(_adcFn fn)
+{
+    adcCallback = fn;
+}
+
+// Copies the last sequence, returns its count (0 before the first one)
+uint32_t getAdc0Samples(uint16_t samples[])
+{
+    uint32_t key = _disable_interrupts();
+    uint32_t sequence = adcSequence;
+    uint8_t i;
+    for (i = 0; i < adcSteps; i++)
+        samples[i] = adcSamples[i];
+    _restore_interrupts(key);
+    return sequence;
+}
+
+// Internal sensor reading in tenths of a degree C,
+// TEMP = 147.5 - 75 * 3.3 V * raw / 4096
+int16_t adc0ToTemp(uint16_t raw)
+{
+    return 1475 - (int32_t)2475 * raw / 4096;
+}
+
+void adc0Ss0Isr(void)
+{
+    uint8_t i = 0;
+    while (!(ADC0_SSFSTAT0_R & ADC_SSFSTAT0_EMPTY))
+    {
+        if (i < ADC0_MAX_INPUTS)
+            adcSamples[i++] = ADC0_SSFIFO0_R;
+        else
+            ADC0_SSFIFO0_R;
+    }
+    adcSequence++;
+    ADC0_ISC_R = ADC_ISC_IN0;
+    if (adcCallback)
+        adcCallback();
+}
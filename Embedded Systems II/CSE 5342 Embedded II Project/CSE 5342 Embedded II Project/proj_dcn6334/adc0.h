@@ -0,0 +1,36 @@
+/*
+ * adc0.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef ADC0_H_
+#define ADC0_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// SS0 has an 8-entry FIFO, one entry per step
+#define ADC0_MAX_INPUTS     8
+// Input value for the internal temperature sensor, AIN0-11 otherwise
+#define ADC0_INPUT_TS       0x80
+
+typedef void (*_adcFn)(void);
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+bool initAdc0(const uint8_t inputs[], uint8_t count, uint32_t rateHz);
+void setAdc0Log2AverageCount(uint8_t log2AverageCount);
+void setAdc0Callback(_adcFn fn);
+uint32_t getAdc0Samples(uint16_t samples[]);
+int16_t adc0ToTemp(uint16_t raw);
+void adc0Ss0Isr(void);
+
+#endif
@@ -0,0 +1,199 @@
+/*
+ * capture.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// Push button on PF4 can be used as the trigger input
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "gpio.h"
+#include "datalog.h"
+#include "ipc.h"
+#include "capture.h"
+
+// Pins
+#define PUSH_BUTTON PORTF,4
+
+#define CAPTURE_ARMED   0
+#define CAPTURE_POST    1
+#define CAPTURE_READY   2
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Circular buffer that always holds the last CAPTURE_SIZE frames
+sampleFrame captureBuffer[CAPTURE_SIZE];
+uint32_t captureWritten = 0;
+
+uint8_t captureState = CAPTURE_ARMED;
+uint8_t capturePre = CAPTURE_SIZE / 2;
+uint8_t capturePost = CAPTURE_SIZE / 2;
+bool capturePinTrigger = false;
+uint8_t postRemaining = 0;
+uint32_t windowStart = 0;
+captureHeader window;
+
+// One bit per trigger source, set from the CLI, the gating task or the pin
+// ISR and consumed with the next frame
+eventGroup captureEvents;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initCapture(void)
+{
+    enablePort(PORTF);
+    selectPinDigitalInput(PUSH_BUTTON);
+    enablePinPullup(PUSH_BUTTON);
+    selectPinInterruptFallingEdge(PUSH_BUTTON);
+    clearPinInterrupt(PUSH_BUTTON);
+    NVIC_EN0_R |= 1 << (INT_GPIOF - 16);
+
+    captureWritten = 0;
+    captureState = CAPTURE_ARMED;
+    initEventGroup(&captureEvents, "capture");
+}
+
+bool setCaptureWindow(uint8_t preCount, uint8_t postCount)
+{
+    if (postCount == 0 || preCount + postCount > CAPTURE_SIZE)
+        return false;
+    capturePre = preCount;
+    capturePost = postCount;
+    return true;
+}
+
+void getCaptureWindow(uint8_t* preCount, uint8_t* postCount)
+{
+    *preCount = capturePre;
+    *postCount = capturePost;
+}
+
+void enableCapturePinTrigger(bool on)
+{
+    capturePinTrigger = on;
+    clearPinInterrupt(PUSH_BUTTON);
+    if (on)
+        enablePinInterrupt(PUSH_BUTTON);
+    else
+        disablePinInterrupt(PUSH_BUTTON);
+}
+
+bool isCapturePinTriggerEnabled(void)
+{
+    return capturePinTrigger;
+}
+
+// Safe to call from an ISR, ignored while a window is being collected
+void triggerCapture(uint8_t source)
+{
+    if (captureState == CAPTURE_ARMED)
+        setEventBits(&captureEvents, 1 << source);
+}
+
+// Called once per frame, returns true when a window is ready to commit
+bool captureFrame(const sampleFrame* frame)
+{
+    uint8_t source;
+    uint32_t available, triggers;
+
+    // Hold the window until it has been written to the log
+    if (captureState == CAPTURE_READY)
+        return false;
+
+    captureBuffer[captureWritten & (CAPTURE_SIZE - 1)] = *frame;
+    captureWritten++;
+
+    if (captureState == CAPTURE_ARMED)
+    {
+        triggers = tryWaitEventBits(&captureEvents, TRIGGER_EVENTS, false, true);
+        if (triggers == 0)
+            return false;
+        // Sources that fired together are reported as the lowest numbered
+        for (source = TRIGGER_CLI; !(triggers & (1 << source)); source++);
+
+        // The trigger frame is the first of the post-trigger frames
+        available = captureWritten - 1;
+        window.preCount = (available < capturePre) ? available : capturePre;
+        window.postCount = capturePost;
+        window.source = source;
+        window.triggerTime = frame->timestamp;
+        window.triggerSequence = frame->sequence;
+        windowStart = captureWritten - 1 - window.preCount;
+        postRemaining = capturePost - 1;
+        captureState = CAPTURE_POST;
+    }
+    else if (postRemaining > 0)
+        postRemaining--;
+
+    if (postRemaining == 0)
+    {
+        captureState = CAPTURE_READY;
+        return true;
+    }
+    return false;
+}
+
+bool isCaptureReady(void)
+{
+    return captureState == CAPTURE_READY;
+}
+
+// Writes the frozen window as one record starting on a page boundary and
+// re-arms the capture, returns the log address of the record. Returns 0 and
+// keeps the window (still ready) when the rest of the log cannot hold it.
+uint32_t commitCapture(void)
+{
+    logHeader header;
+    uint32_t add;
+    uint8_t i, count;
+
+    if (captureState != CAPTURE_READY)
+        return 0;
+
+    count = window.preCount + window.postCount;
+    header.type = LOG_RECORD_CAPTURE;
+    header.reserved = 0;
+    header.length = sizeof(captureHeader) + count * sizeof(sampleFrame);
+
+    // The record starts on the next page boundary
+    add = (getLogAddress() + LOG_PAGE_SIZE - 1) & ~(uint32_t)(LOG_PAGE_SIZE - 1);
+    if (add + sizeof(header) + header.length > LOG_END)
+        return 0;
+
+    alignLog();
+    add = getLogAddress();
+    writeLog(&header, sizeof(header));
+    writeLog(&window, sizeof(window));
+    for (i = 0; i < count; i++)
+        writeLog(&captureBuffer[(windowStart + i) & (CAPTURE_SIZE - 1)], sizeof(sampleFrame));
+    alignLog();
+
+    captureState = CAPTURE_ARMED;
+    return add;
+}
+
+void gpioPortFIsr(void)
+{
+    clearPinInterrupt(PUSH_BUTTON);
+    triggerCapture(TRIGGER_PIN);
+}
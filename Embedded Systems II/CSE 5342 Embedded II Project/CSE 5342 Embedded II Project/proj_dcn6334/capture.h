@@ -0,0 +1,65 @@
+/*
+ * capture.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// Push button on PF4 can be used as the trigger input
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef CAPTURE_H_
+#define CAPTURE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sample.h"
+
+// Frames held in RAM, the pre- and post-trigger counts must fit together
+#define CAPTURE_SIZE        32
+
+#define TRIGGER_NONE        0
+#define TRIGGER_CLI         1
+#define TRIGGER_PIN         2
+#define TRIGGER_THRESHOLD   3
+#define TRIGGER_EVENTS      ((1 << TRIGGER_CLI) | (1 << TRIGGER_PIN) | (1 << TRIGGER_THRESHOLD))
+
+// Written to the log ahead of the frames of a capture window
+typedef struct _captureHeader
+{
+    uint32_t triggerTime;
+    uint16_t triggerSequence;
+    uint8_t source;
+    uint8_t preCount;
+    uint8_t postCount;
+    uint8_t reserved[3];
+} captureHeader;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initCapture(void);
+bool setCaptureWindow(uint8_t preCount, uint8_t postCount);
+void getCaptureWindow(uint8_t* preCount, uint8_t* postCount);
+void enableCapturePinTrigger(bool on);
+bool isCapturePinTriggerEnabled(void);
+void triggerCapture(uint8_t source);
+bool captureFrame(const sampleFrame* frame);
+bool isCaptureReady(void);
+uint32_t commitCapture(void);
+void gpioPortFIsr(void);
+
+#endif
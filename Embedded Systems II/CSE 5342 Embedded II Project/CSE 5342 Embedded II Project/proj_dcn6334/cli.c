@@ -12,8 +12,9 @@
 #include "gpio.h"
 #include "cli.h"
 #include "tString.h"
-
-#include <stdio.h>  // This will be removed from the future version as it takes 4096 Bytes of stack space to call
+#include "kernel.h"
+#include "ipc.h"
+#include "format.h"
 
 #define MAX_HISTORY_NUMBER              5
 #define MAX_HISTORY_COMMAND_LENGTH      10
@@ -25,10 +26,11 @@ uint8_t historyWritePtr = 0;
 
 void updateHistory(const char* command)
 {
-    // Copy over the command to the history buffer
+    // Copy over the command to the history buffer, truncated and terminated
     uint8_t i = 0;
-    for(i = 0; command[i] != '\0' && i < MAX_HISTORY_COMMAND_LENGTH; i++)
+    for(i = 0; i < MAX_HISTORY_COMMAND_LENGTH - 1 && command[i] != '\0'; i++)
         history[historyWritePtr][i] = command[i];
+    history[historyWritePtr][i] = '\0';
     historyWritePtr = (historyWritePtr + 1) % MAX_HISTORY_NUMBER;
 }
 
@@ -37,93 +39,178 @@ char* getCommandFromHistory()
     return 0;
 }
 
-// Gets a user defined string using the serial peripheral Uart0
-void getsUart0(USER_DATA* data)
+// Assembles a line from whatever bytes UART0 has received so far without
+// waiting for more, echoing them back. Returns true once a line is complete;
+// the partial line is kept in data->count between calls.
+bool getsUart0(USER_DATA* data)
 {
-    // Keeps count of how many characters we currently have in the buffer
-    // Also serves to provide us with the position of the last character input
-    uint8_t count = 0;
+    char c;
 
-    while(true)
+    while(tryGetcUart0(&c))
     {
-        char c = getcUart0();
-
         // If the character is a backspace
         // Ctrl-H or Ctrl-?
         if(c == 8 || c == 127)
         {
-            // If the count is greater than zero, we decrement the count
-            // This means we are essentially erasing the previous character
-            // Else, we just look for new characters
-            if(count > 0)
-                count--;
-            else
-                continue;
+            // Erase the previous character on the terminal as well
+            if(data->count > 0)
+            {
+                data->count--;
+                putsUart0("\b \b");
+            }
         }
         // If the character is a carriage return (13) or a line feed (10)
         else if(c == 13 || c == 10)
         {
-            data->buffer[count] = 0;
+            data->buffer[data->count] = 0;
+            data->count = 0;
+            putsUart0("\r\n");
             // Store the current command in the history buffer
             updateHistory(data->buffer);
-            return;
+            return true;
         }
-        else if(c < 32)
-            continue;
         // If the character is anything greater than a space
         else if(c >= 32)
         {
-            data->buffer[count++] = c;
-            if(count == MAX_CHARS)
+            data->buffer[data->count++] = c;
+            putcUart0(c);
+            if(data->count == MAX_CHARS)
             {
-                data->buffer[count] = '\0';
-                return;
+                data->buffer[data->count] = '\0';
+                data->count = 0;
+                putsUart0("\r\n");
+                return true;
             }
         }
     }
+    return false;
 }
 
-// Tokenizes the string in place
+// Character classes, a character with none of them is a delimiter. '&' and
+// '_' count as letters; the other punctuation separates fields.
+#define CC_ALPHA    0x01
+#define CC_DIGIT    0x02
+#define CC_HEX      0x04
+#define CC_SIGN     0x08
+#define CC_POINT    0x10
+
+#define A CC_ALPHA
+#define D CC_DIGIT
+#define H CC_HEX
+#define S CC_SIGN
+#define P CC_POINT
+const uint8_t charClass[256] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, A, 0, 0, 0, 0, S, 0, S, P, 0,
+    D|H, D|H, D|H, D|H, D|H, D|H, D|H, D|H, D|H, D|H, 0, 0, 0, 0, 0, 0,
+    0, A|H, A|H, A|H, A|H, A|H, A|H, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, A,
+    0, A|H, A|H, A|H, A|H, A|H, A|H, A, A, A, A, A, A, A, A, A,
+    A, A, A, A, A, A, A, A, A, A, A, 0, 0, 0, 0, 0,
+    // 0x80-0xFF are delimiters
+};
+#undef A
+#undef D
+#undef H
+#undef S
+#undef P
+
+// States of the number recognizer run alongside the tokenizer
+#define NUM_START       0
+#define NUM_SIGN        1
+#define NUM_ZERO        2
+#define NUM_INT         3
+#define NUM_POINT       4               // point with no digit before it
+#define NUM_INT_POINT   5
+#define NUM_FRAC        6
+#define NUM_HEX_X       7
+#define NUM_HEX         8
+#define NUM_BAD         9
+
+// Number formats: [+-]digits[.digits], [+-].digits, [+-]0xhex
+uint8_t nextNumberState(uint8_t state, char c, uint8_t cls)
+{
+    switch(state)
+    {
+    case NUM_START:
+        if(cls & CC_SIGN) return NUM_SIGN;
+        // fall through
+    case NUM_SIGN:
+        if(c == '0') return NUM_ZERO;
+        if(cls & CC_DIGIT) return NUM_INT;
+        if(cls & CC_POINT) return NUM_POINT;
+        return NUM_BAD;
+    case NUM_ZERO:
+        if(c == 'x' || c == 'X') return NUM_HEX_X;
+        // fall through
+    case NUM_INT:
+        if(cls & CC_DIGIT) return NUM_INT;
+        if(cls & CC_POINT) return NUM_INT_POINT;
+        return NUM_BAD;
+    case NUM_POINT:
+    case NUM_INT_POINT:
+    case NUM_FRAC:
+        if(cls & CC_DIGIT) return NUM_FRAC;
+        return NUM_BAD;
+    case NUM_HEX_X:
+    case NUM_HEX:
+        if(cls & CC_HEX) return NUM_HEX;
+        return NUM_BAD;
+    }
+    return NUM_BAD;
+}
+
+bool isNumberState(uint8_t state)
+{
+    return state == NUM_ZERO || state == NUM_INT || state == NUM_INT_POINT ||
+           state == NUM_FRAC || state == NUM_HEX;
+}
+
+// Tokenizes the string in place in one pass: delimiters become null
+// terminators and each field is typed 'n' (number) or 'a' (anything else).
+// Fields after MAX_FIELDS are ignored.
 void parseField(USER_DATA* data)
 {
+    bool inToken = false;
+    uint8_t state = NUM_START;
+    uint8_t i, cls;
+    char c;
+
     data->fieldCount = 0;
-    bool isNewToken = false;
-    uint8_t i = 0;
-    for(i = 0; (data->buffer[i] != '\0') && (data->fieldCount < MAX_FIELDS); i++)
+    for(i = 0; (c = data->buffer[i]) != '\0'; i++)
     {
-        // Only tokenize alpha numeric characters
-        if(((data->buffer[i] >= 'a' && data->buffer[i] <= 'z') ||
-            (data->buffer[i] >= '0' && data->buffer[i] <= '9') ||
-            (data->buffer[i] >= 'A' && data->buffer[i] <= 'Z') ||
-             data->buffer[i] >= '&') &&
-            !isNewToken)
+        cls = charClass[(uint8_t)c];
+        if(cls == 0)
         {
-            isNewToken = true;
-            // Record where this new token starts
-            data->fieldPosition[data->fieldCount] = i;
-            if(data->buffer[i] >= '0' && data->buffer[i] <= '9')
-                data->fieldType[data->fieldCount++] = 'n';
-            else
-                data->fieldType[data->fieldCount++] = 'a';
-        }
-        else if(!(data->buffer[i] >= 'a' && data->buffer[i] <= 'z') &&
-                !(data->buffer[i] >= '0' && data->buffer[i] <= '9') &&
-                !(data->buffer[i] >= 'A' && data->buffer[i] <= 'Z') &&
-                !(data->buffer[i] >= '&'))
-        {
-            isNewToken = false;
+            if(inToken)
+                data->fieldType[data->fieldCount++] = isNumberState(state) ? 'n' : 'a';
+            inToken = false;
             // Replace the delimeters with null terminators
             data->buffer[i] = '\0';
         }
+        else if(!inToken)
+        {
+            if(data->fieldCount == MAX_FIELDS)
+                break;
+            inToken = true;
+            // Record where this new token starts
+            data->fieldPosition[data->fieldCount] = i;
+            state = nextNumberState(NUM_START, c, cls);
+        }
+        else
+            state = nextNumberState(state, c, cls);
     }
-    return;
+    if(inToken)
+        data->fieldType[data->fieldCount++] = isNumberState(state) ? 'n' : 'a';
 }
 
 // Checks to see if a particular command is valid or not
 bool isCommand(USER_DATA* data, const char strCommand[], uint8_t minArguments)
 {
     // Only count the arguments
-    if(data->fieldCount - 1 < minArguments) return false;
+    if(data->fieldCount == 0 || data->fieldCount - 1 < minArguments) return false;
     if(stringCompare(getFieldString(data, 0), strCommand, MAX_CHARS)) return true;
     return false;
 }
@@ -138,20 +225,57 @@ char* getFieldString(USER_DATA* data, uint8_t fieldNumber)
     return 0;
 }
 
-// Returns a 32-bit signed integer
-int32_t getFieldInteger(USER_DATA* data, uint8_t fieldNumber)
+// value * base + digit, stuck at limit instead of overflowing
+uint32_t addDigit(uint32_t value, uint8_t base, uint8_t digit, uint32_t limit)
 {
-    int32_t signedInteger32bits = 0;
-    if((fieldNumber < MAX_FIELDS) &&
-       (fieldNumber < data->fieldCount) &&
-       (data->fieldType[fieldNumber] == 'n'))
+    if(value > (limit - digit) / base)
+        return limit;
+    return value * base + digit;
+}
+
+// Returns a number field as a signed fixed-point value with scale decimal
+// places ("-2.5" with scale 2 is -250), 0 if the field is not a number.
+// Extra decimals are truncated, hex fields are whole numbers. Decimal values
+// saturate at the int32_t range, hex values at 0xFFFFFFFF (a 32-bit pattern).
+int32_t getFieldFixed(USER_DATA* data, uint8_t fieldNumber, uint8_t scale)
+{
+    uint32_t value = 0;
+    uint32_t limit;
+    bool negative = false;
+    char* p;
+    if((fieldNumber >= MAX_FIELDS) ||
+       (fieldNumber >= data->fieldCount) ||
+       (data->fieldType[fieldNumber] != 'n'))
+        return 0;
+
+    p = data->buffer + data->fieldPosition[fieldNumber];
+    if(*p == '-' || *p == '+')
+        negative = (*p++ == '-');
+    if(p[0] == '0' && (p[1] == 'x' || p[1] == 'X'))
     {
-         char* numberString = data->buffer + data->fieldPosition[fieldNumber];
-         uint8_t i;
-         for(i = 0; numberString[i] != '\0'; i++)
-             signedInteger32bits = (signedInteger32bits * 10) + (numberString[i] - '0');
+        limit = 0xFFFFFFFF;
+        for(p += 2; *p; p++)
+            value = addDigit(value, 16, (*p <= '9') ? *p - '0' : (*p | 0x20) - 'a' + 10, limit);
     }
-    return signedInteger32bits;
+    else
+    {
+        limit = negative ? 0x80000000 : 0x7FFFFFFF;
+        for(; charClass[(uint8_t)*p] & CC_DIGIT; p++)
+            value = addDigit(value, 10, *p - '0', limit);
+        if(*p == '.')
+            p++;
+        for(; scale && (charClass[(uint8_t)*p] & CC_DIGIT); p++, scale--)
+            value = addDigit(value, 10, *p - '0', limit);
+    }
+    for(; scale; scale--)
+        value = addDigit(value, 10, 0, limit);
+    return negative ? (int32_t)(0 - value) : (int32_t)value;
+}
+
+// Returns a 32-bit signed integer, decimal or 0x hex
+int32_t getFieldInteger(USER_DATA* data, uint8_t fieldNumber)
+{
+    return getFieldFixed(data, fieldNumber, 0);
 }
 
 // To be removed later
@@ -166,56 +290,97 @@ void rebootSystem()
     NVIC_APINT_R = (0x05FA0000 | NVIC_APINT_SYSRESETREQ);
 }
 
-// Displays the process (thread) information
+const char* stateNames[] = {"invalid", "ready", "delayed", "blocked", "killed"};
+
+// Displays the process (thread) information, CPU usage is since the last ps
 void ps()
 {
-    putsUart0("PS called\n");
+    threadInfo info;
+    uint64_t total = 0;
+    uint32_t usage;
+    int8_t pid;
+
+    for(pid = 0; getThreadInfo(pid, &info); pid++)
+        total += info.cpuCycles;
+    putsUart0("PID  Name         Prio  State     CPU%   Max block us  Stack\n");
+    for(pid = 0; getThreadInfo(pid, &info); pid++)
+    {
+        usage = total ? (uint64_t)info.cpuCycles * 1000 / total : 0;
+        printfUart0("%-4d %-12s %d/%d   %-8s %5.1k  %-12d  %d/%d\n", pid, info.name, info.currentPriority,
+                info.priority, stateNames[info.state], usage, info.maxBlocked / 40,
+                info.stackUsed, info.stackSize);
+    }
+    printfUart0("Main stack %d/%d, thread stacks %d/%d bytes\n", getMainStackUsed(), getMainStackSize(),
+            getStackPoolUsed(), KERNEL_STACK_POOL);
+    resetThreadCpu();
 }
 
+const char* ipcTypeNames[] = {"queue", "sem", "events"};
+
 // Displays the inter-process (thread) communication state
 void ipcs()
 {
-    putsUart0("IPCS called\n");
+    mutex* m;
+    ipcObject* o;
+    uint32_t value;
+
+    putsUart0("Name         Type    Owner  Locks     Contended\n");
+    for(m = getMutexList(); m != 0; m = m->next)
+    {
+        printfUart0("%-12s mutex   %-5d  %-9d %d\n", m->name, m->owner, m->locks, m->contended);
+    }
+    putsUart0("Name         Type    Value  High  Waits     Failed    Waiting\n");
+    for(o = getIpcList(); o != 0; o = o->next)
+    {
+        if(o->type == IPC_QUEUE)
+            value = ((queue*)o)->count;
+        else if(o->type == IPC_SEMAPHORE)
+            value = ((semaphore*)o)->count;
+        else
+            value = ((eventGroup*)o)->bits;
+        printfUart0("%-12s %-7s %-6d %-5d %-9d %-9d 0x%02x\n", o->name, ipcTypeNames[o->type],
+                value, o->highWater, o->waits, o->failed, o->waiters);
+    }
 }
 
 // Kills the process (thread) with matching PID
 void kill(int32_t pid)
 {
-    char buffer[16];
-    sprintf(buffer, "pid %d killed\n", pid);
-    putsUart0(buffer);
+    if(pid >= 0 && pid < MAX_THREADS && killThread(pid))
+        printfUart0("pid %d killed\n", pid);
+    else
+        printfUart0("pid %d cannot be killed\n", pid);
 }
 
 // Turns priority inheritance on or off
 void pi(bool on)
 {
-    char buffer[16];
-    sprintf(buffer, "PI %s\n", (on) ? "on" : "off");
-    putsUart0(buffer);
+    setPriorityInheritance(on);
+    printfUart0("PI %s\n", (on) ? "on" : "off");
 }
 
 // Turns preemption on or off
 void preempt(bool on)
 {
-    char buffer[16];
-    sprintf(buffer, "preempt %s\n", (on) ? "on" : "off");
-    putsUart0(buffer);
+    setPreemption(on);
+    printfUart0("preempt %s\n", (on) ? "on" : "off");
 }
 
 // Selected priority or round-robin scheduling
 void sched(bool prioOn)
 {
-    char buffer[16];
-    sprintf(buffer, "sched %s\n", (prioOn) ? "prio" : "rr");
-    putsUart0(buffer);
+    setPriorityScheduling(prioOn);
+    printfUart0("sched %s\n", (prioOn) ? "prio" : "rr");
 }
 
 // Displays the PID of the process (thread)
 void pidof(char name[])
 {
-    char buffer[32];
-    sprintf(buffer, "%s launched\n", name);
-    putsUart0(buffer);
+    int8_t pid = getPid(name);
+    if(pid >= 0)
+        printfUart0("%d\n", pid);
+    else
+        printfUart0("%s not found\n", name);
 }
 
 void shell(void)
@@ -225,11 +390,12 @@ void shell(void)
     initLed();
 
     USER_DATA data;
+    data.count = 0;
 
     while(true)
     {
         putcUart0('>');
-        getsUart0(&data);
+        while(!getsUart0(&data));
         parseField(&data);
 
         if(isCommand(&data, "reboot", 0))
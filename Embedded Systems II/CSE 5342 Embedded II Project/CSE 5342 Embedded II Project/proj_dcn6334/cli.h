@@ -18,6 +18,7 @@
 typedef struct _USER_DATA
 {
     char buffer[MAX_CHARS + 1];
+    uint8_t count;                      // characters typed so far
     uint8_t fieldCount;
     uint8_t fieldPosition[MAX_FIELDS];
     char fieldType[MAX_FIELDS];
@@ -25,9 +26,17 @@ typedef struct _USER_DATA
 
 bool isCommand(USER_DATA* data, const char strCommand[], uint8_t minArguments);
 int32_t getFieldInteger(USER_DATA* data, uint8_t fieldNumber);
+int32_t getFieldFixed(USER_DATA* data, uint8_t fieldNumber, uint8_t scale);
 char* getFieldString(USER_DATA* data, uint8_t fieldNumber);
 void parseField(USER_DATA* data);
-void getsUart0(USER_DATA* data);
+bool getsUart0(USER_DATA* data);
+void ps();
+void ipcs();
+void kill(int32_t pid);
+void pi(bool on);
+void preempt(bool on);
+void sched(bool prioOn);
+void pidof(char name[]);
 void shell(void);
 
 #endif /* COMMON_TERMINAL_INTERFACE_H_ */
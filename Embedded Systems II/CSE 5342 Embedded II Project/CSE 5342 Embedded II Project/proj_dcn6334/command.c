@@ -0,0 +1,152 @@
+/*
+ * command.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+#include "tString.h"
+#include "command.h"
+
+#define MAX_SEED            0xFFFF
+#define HELP_COLUMN         14
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const command* commands = 0;
+uint8_t commandCount = 0;
+
+// Perfect hash: every command has its own slot for hashSeed, a slot holds
+// the table index + 1 (0 = empty). perfectHash is false if no seed was found
+// and the lookup falls back to a linear search.
+uint8_t commandSlots[COMMAND_SLOTS];
+uint32_t hashSeed = 0;
+bool perfectHash = false;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// FNV-1a with the seed mixed into the offset basis. The low bits of FNV only
+// depend on the low bits of the seed, so the slot comes from the top bits.
+uint8_t hashCommand(const char name[], uint32_t seed)
+{
+    uint32_t hash = 2166136261u ^ seed;
+    while (*name)
+        hash = (hash ^ (uint8_t)*name++) * 16777619u;
+    return hash >> (32 - COMMAND_HASH_BITS);
+}
+
+// Searches for a seed that maps every command to a different slot
+bool initCommands(const command table[], uint8_t count)
+{
+    uint32_t seed;
+    uint8_t i, j, slot;
+    bool collision;
+
+    commands = table;
+    commandCount = count;
+    perfectHash = false;
+    if (count >= COMMAND_SLOTS)
+        return false;
+
+    for (seed = 0; seed <= MAX_SEED; seed++)
+    {
+        for (j = 0; j < COMMAND_SLOTS; j++)
+            commandSlots[j] = 0;
+        collision = false;
+        for (i = 0; i < count && !collision; i++)
+        {
+            slot = hashCommand(table[i].name, seed);
+            if (commandSlots[slot])
+                collision = true;
+            else
+                commandSlots[slot] = i + 1;
+        }
+        if (!collision)
+        {
+            hashSeed = seed;
+            perfectHash = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+// One hash and one string compare, unknown names land in an empty slot or
+// fail the compare
+const command* findCommand(const char name[])
+{
+    uint8_t i;
+    if (name == 0 || commands == 0)
+        return 0;
+    if (perfectHash)
+    {
+        i = commandSlots[hashCommand(name, hashSeed)];
+        if (i && stringCompare(name, commands[i - 1].name, MAX_CHARS))
+            return &commands[i - 1];
+        return 0;
+    }
+    for (i = 0; i < commandCount; i++)
+        if (stringCompare(name, commands[i].name, MAX_CHARS))
+            return &commands[i];
+    return 0;
+}
+
+// Runs the command of a parsed line, returns false if it was not run
+bool runCommand(USER_DATA* data)
+{
+    const command* cmd;
+    char* name = getFieldString(data, 0);
+
+    if (name == 0)
+    {
+        if (data->fieldCount)
+            putsUart0("Invalid command\r\n");
+        return false;
+    }
+    cmd = findCommand(name);
+    if (cmd == 0)
+    {
+        putsUart0("Invalid command, type help\r\n");
+        return false;
+    }
+    if (data->fieldCount - 1 < cmd->minArgs)
+    {
+        putsUart0("Usage: ");
+        putsUart0(cmd->name);
+        putcUart0(' ');
+        putsUart0(cmd->help);
+        putsUart0("\r\n");
+        return false;
+    }
+    cmd->handler(data);
+    return true;
+}
+
+// Help text generated from the table
+void printCommands(void)
+{
+    uint8_t i, n;
+    for (i = 0; i < commandCount; i++)
+    {
+        putsUart0(commands[i].name);
+        n = 0;
+        while (commands[i].name[n])
+            n++;
+        do
+            putcUart0(' ');
+        while (++n < HELP_COLUMN);
+        putsUart0(commands[i].help);
+        putsUart0("\r\n");
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * command.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef COMMAND_H_
+#define COMMAND_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cli.h"
+
+// 2^COMMAND_HASH_BITS slots, at least three times the number of commands
+// keeps the seed search at boot short
+#define COMMAND_HASH_BITS   7
+#define COMMAND_SLOTS       (1 << COMMAND_HASH_BITS)
+
+typedef void (*_commandFn)(USER_DATA* data);
+
+// One entry of the command table
+typedef struct _command
+{
+    const char* name;
+    uint8_t minArgs;
+    _commandFn handler;
+    const char* help;                   // arguments and description
+} command;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+bool initCommands(const command table[], uint8_t count);
+const command* findCommand(const char name[]);
+bool runCommand(USER_DATA* data);
+void printCommands(void);
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * config.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// Internal EEPROM, CONFIG_WORDS words from CONFIG_BASE
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "eeprom.h"
+#include "crc16.h"
+#include "config.h"
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// The struct is only 2-byte aligned, so each EEPROM word is copied with
+// memcpy rather than through a uint32_t pointer
+
+// Reads the block into c, returns false (c then holds garbage) if it is
+// missing, from another layout version or fails the CRC
+bool loadConfig(config* c)
+{
+    uint8_t* bytes = (uint8_t*)c;
+    uint32_t word;
+    uint8_t i;
+    for (i = 0; i < CONFIG_WORDS; i++)
+    {
+        word = readEeprom(CONFIG_BASE + i);
+        memcpy(bytes + i * 4, &word, 4);
+    }
+    return c->magic == CONFIG_MAGIC && c->version == CONFIG_VERSION &&
+           c->words == CONFIG_WORDS &&
+           c->crc == crc16(c, sizeof(config) - sizeof(c->crc), CRC16_INIT);
+}
+
+// Each EEPROM write wears the block and takes a few hundred us, so only the
+// words that differ are written. Returns the number written.
+uint8_t saveConfig(config* c)
+{
+    const uint8_t* bytes = (const uint8_t*)c;
+    uint32_t word;
+    uint8_t i, written = 0;
+    c->magic = CONFIG_MAGIC;
+    c->version = CONFIG_VERSION;
+    c->words = CONFIG_WORDS;
+    c->reserved = 0;
+    c->crc = crc16(c, sizeof(config) - sizeof(c->crc), CRC16_INIT);
+    for (i = 0; i < CONFIG_WORDS; i++)
+    {
+        memcpy(&word, bytes + i * 4, 4);
+        if (readEeprom(CONFIG_BASE + i) != word)
+        {
+            writeEeprom(CONFIG_BASE + i, word);
+            written++;
+        }
+    }
+    return written;
+}
+
+// The next boot uses the defaults
+void eraseConfig(void)
+{
+    writeEeprom(CONFIG_BASE, 0xFFFFFFFF);
+}
@@ -0,0 +1,61 @@
+/*
+ * config.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rules.h"
+#include "script.h"
+
+// Internal EEPROM word address, the block has to stay below SCRIPT_BASE
+#define CONFIG_BASE         0
+#define CONFIG_MAGIC        0x4346      // "CF"
+// Bump when the layout changes, an older block then falls back to defaults
+#define CONFIG_VERSION      1
+#define CONFIG_WORDS        (sizeof(config) / 4)
+
+// Settings restored at boot (84 bytes with 8 rules), read and written as
+// whole EEPROM words
+typedef struct _config
+{
+    uint16_t magic;
+    uint8_t version;
+    uint8_t words;
+    uint16_t acquisitionPeriod;         // ms
+    uint16_t i2cSpeed;                  // kbps, 0 leaves the initI2c0 rate
+    uint8_t encrypt;
+    uint8_t key;
+    uint8_t leveling;
+    uint8_t ruleCount;
+    int16_t hysteresis;
+    uint8_t capturePre;
+    uint8_t capturePost;
+    ruleSetting rules[MAX_RULES];
+    uint8_t capturePin;
+    uint8_t reserved;
+    uint16_t crc;                       // CRC-16 of everything before it
+} config;
+
+// The block is copied in whole EEPROM words and must not reach the boot script
+typedef char configIsWholeWords[(sizeof(config) % 4 == 0) ? 1 : -1];
+typedef char configFitsBelowScript[(CONFIG_BASE + CONFIG_WORDS <= SCRIPT_BASE) ? 1 : -1];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+bool loadConfig(config* c);
+uint8_t saveConfig(config* c);
+void eraseConfig(void);
+
+#endif
@@ -0,0 +1,41 @@
+/*
+ * crc16.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include "crc16.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// One nibble at a time, 32 bytes of table instead of 512
+const uint16_t crcNibble[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Pass CRC16_INIT to start, or the previous result to continue a block
+uint16_t crc16(const void* data, uint16_t size, uint16_t crc)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    while (size--)
+    {
+        crc = (crc << 4) ^ crcNibble[(crc >> 12) ^ (*p >> 4)];
+        crc = (crc << 4) ^ crcNibble[(crc >> 12) ^ (*p & 0x0F)];
+        p++;
+    }
+    return crc;
+}
@@ -0,0 +1,26 @@
+/*
+ * crc16.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef CRC16_H_
+#define CRC16_H_
+
+#include <stdint.h>
+
+// CRC-16/CCITT-FALSE: polynomial 0x1021, no reflection, no final xor
+#define CRC16_INIT          0xFFFF
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+uint16_t crc16(const void* data, uint16_t size, uint16_t crc);
+
+#endif
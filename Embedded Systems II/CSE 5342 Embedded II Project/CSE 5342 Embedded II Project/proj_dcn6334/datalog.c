@@ -0,0 +1,225 @@
+/*
+ * datalog.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// 24LC512 EEPROM on I2C0 at address 0xA0 (A0-A2 low)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "i2c0.h"
+#include "datalog.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Records are packed into one of two RAM pages. A full page is queued and
+// written by serviceLog once the device answers ACK polling, while new
+// records go into the other page.
+uint8_t logPages[2][LOG_PAGE_SIZE];
+uint8_t logFillPage = 0;
+uint16_t logPageFill = 0;
+uint32_t logPageAddress = LOG_START;
+uint32_t logBytesWritten = 0;
+
+// Queued pages, at most one besides the one being filled
+bool logPagePending[2] = {false, false};
+uint32_t logPendingAddress[2];
+uint16_t logPendingSize[2];
+uint8_t logWritePage = 0;
+
+// Pages written by serviceLog and times a full page had to wait for the device
+uint32_t logPagesWritten = 0;
+uint32_t logStalls = 0;
+
+// Called when a page is queued so the owner can start polling
+void (*logQueuedHook)(void) = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// The 24LC512 does not acknowledge its address during the internal write
+// cycle (up to 5 ms), so poll until it does
+void waitLogReady()
+{
+    while (!pollI2c0Address(LOG_I2C_ADDR));
+}
+
+// Starts the oldest queued page if the device has finished the last write
+// cycle, returns true if a page is still queued
+bool serviceLog(void)
+{
+    uint8_t page = logWritePage;
+    if (!logPagePending[page])
+        return false;
+    if (!pollI2c0Address(LOG_I2C_ADDR))
+        return true;
+    writeI2c0Registers16(LOG_I2C_ADDR, logPendingAddress[page], logPages[page], logPendingSize[page]);
+    logPagePending[page] = false;
+    logWritePage = page ^ 1;
+    logPagesWritten++;
+    return logPagePending[logWritePage];
+}
+
+bool isLogBusy(void)
+{
+    return logPagePending[0] || logPagePending[1];
+}
+
+// Blocks until every queued page has been handed to the device and its
+// write cycle has finished
+void drainLog(void)
+{
+    while (serviceLog());
+    waitLogReady();
+}
+
+// Queues the page being filled and moves to the other one. If that one is
+// still queued the device is behind and this has to wait for it.
+void queueLogPage(uint16_t size, bool advance)
+{
+    uint8_t next = logFillPage ^ 1;
+    if (logPagePending[next])
+    {
+        logStalls++;
+        while (logPagePending[next])
+            serviceLog();
+    }
+    logPagePending[logFillPage] = true;
+    logPendingAddress[logFillPage] = logPageAddress;
+    logPendingSize[logFillPage] = size;
+    if (!logPagePending[logWritePage])
+        logWritePage = logFillPage;
+    if (logQueuedHook)
+        logQueuedHook();
+    if (advance)
+    {
+        logFillPage = next;
+        logPageAddress += LOG_PAGE_SIZE;
+        logPageFill = 0;
+    }
+}
+
+// The log starts over at every boot, like the metadata table
+void initLog(void)
+{
+    logFillPage = 0;
+    logPageFill = 0;
+    logPageAddress = LOG_START;
+    logBytesWritten = 0;
+    logPagePending[0] = false;
+    logPagePending[1] = false;
+    logWritePage = 0;
+    logPagesWritten = 0;
+    logStalls = 0;
+}
+
+// Appends bytes to the log, or nothing if they do not all fit
+bool writeLog(const void* data, uint16_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint16_t i;
+    if (size > getLogFree())
+        return false;
+    for (i = 0; i < size; i++)
+    {
+        logPages[logFillPage][logPageFill++] = bytes[i];
+        if (logPageFill == LOG_PAGE_SIZE)
+            queueLogPage(LOG_PAGE_SIZE, true);
+    }
+    logBytesWritten += size;
+    return true;
+}
+
+// Writes the header and payload, or nothing if the record does not fit, so
+// the log never ends in a torn record
+bool writeLogRecord(uint8_t type, const void* data, uint16_t size)
+{
+    logHeader header;
+    if ((uint32_t)sizeof(header) + size > getLogFree())
+        return false;
+    header.type = type;
+    header.reserved = 0;
+    header.length = size;
+    writeLog(&header, sizeof(header));
+    writeLog(data, size);
+    return true;
+}
+
+// Pads the current page and queues it so the next record starts on a page
+void alignLog(void)
+{
+    if (logPageFill == 0 || logPageAddress >= LOG_END)
+        return;
+    while (logPageFill < LOG_PAGE_SIZE)
+        logPages[logFillPage][logPageFill++] = LOG_RECORD_PAD;
+    queueLogPage(LOG_PAGE_SIZE, true);
+}
+
+// Writes out everything logged so far, including the partially filled
+// page, without moving to the next page
+void flushLog(void)
+{
+    if (logPageFill != 0 && logPageAddress < LOG_END)
+    {
+        drainLog();
+        queueLogPage(logPageFill, false);
+    }
+    drainLog();
+}
+
+// Other users of the device have to wait for the queued pages
+void readLog(uint32_t add, uint8_t data[], uint16_t size)
+{
+    drainLog();
+    readI2c0Registers16(LOG_I2C_ADDR, add, data, size);
+}
+
+void setLogQueuedHook(void (*fn)(void))
+{
+    logQueuedHook = fn;
+}
+
+uint32_t getLogAddress(void)
+{
+    return logPageAddress + logPageFill;
+}
+
+// Bytes left before the end of the device
+uint32_t getLogFree(void)
+{
+    return LOG_END - getLogAddress();
+}
+
+uint32_t getLogBytesWritten(void)
+{
+    return logBytesWritten;
+}
+
+uint32_t getLogPagesWritten(void)
+{
+    return logPagesWritten;
+}
+
+uint32_t getLogStalls(void)
+{
+    return logStalls;
+}
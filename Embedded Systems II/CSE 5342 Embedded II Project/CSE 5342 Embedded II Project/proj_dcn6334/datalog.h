@@ -0,0 +1,70 @@
+/*
+ * datalog.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target Platform: EK-TM4C123GXL
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// 24LC512 EEPROM on I2C0 at address 0xA0 (A0-A2 low)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef DATALOG_H_
+#define DATALOG_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LOG_I2C_ADDR        (0xA0 >> 1)
+#define LOG_PAGE_SIZE       128
+// 0x0000-0x01FF holds the metadata table and the per-sensor records
+#define LOG_START           0x0200
+#define LOG_END             0x10000
+
+// Record types, 0xFF is the padding up to the next page
+#define LOG_RECORD_CAPTURE          1
+#define LOG_RECORD_SESSION_START    2
+#define LOG_RECORD_SESSION_END      3
+#define LOG_RECORD_FRAME            4
+#define LOG_RECORD_PAD              0xFF
+
+// Every record in the log starts with this header
+typedef struct _logHeader
+{
+    uint8_t type;
+    uint8_t reserved;
+    uint16_t length;                    // payload bytes following the header
+} logHeader;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initLog(void);
+bool writeLog(const void* data, uint16_t size);
+bool writeLogRecord(uint8_t type, const void* data, uint16_t size);
+void alignLog(void);
+void flushLog(void);
+bool serviceLog(void);
+bool isLogBusy(void);
+void drainLog(void);
+void setLogQueuedHook(void (*fn)(void));
+void readLog(uint32_t add, uint8_t data[], uint16_t size);
+uint32_t getLogAddress(void);
+uint32_t getLogFree(void);
+uint32_t getLogBytesWritten(void);
+uint32_t getLogPagesWritten(void);
+uint32_t getLogStalls(void);
+
+#endif
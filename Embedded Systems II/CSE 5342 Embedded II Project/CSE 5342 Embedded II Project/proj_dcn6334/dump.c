@@ -0,0 +1,266 @@
+/*
+ * dump.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// 24LC512 EEPROM on I2C0, console on UART0 with uDMA transmit
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+#include "format.h"
+#include "crc16.h"
+#include "datalog.h"
+#include "stream.h"
+#include "scheduler.h"
+#include "ipc.h"
+#include "dump.h"
+
+#define DUMP_BYTES_PER_LINE 16
+// Largest formatted chunk: CSV lines of "65535" and 16 x ",255" plus CRLF
+#define DUMP_TEXT_SIZE      ((DUMP_CHUNK / DUMP_BYTES_PER_LINE) * (5 + DUMP_BYTES_PER_LINE * 4 + 2))
+#define DUMP_PACKET_SIZE    (sizeof(dumpHeader) + DUMP_CHUNK + 2)
+
+#define BUFFER_FREE         0
+#define BUFFER_READY        1
+#define BUFFER_SENDING      2
+
+// Formatted chunk waiting for or being sent by uDMA
+typedef struct _dumpBuffer
+{
+    char text[DUMP_TEXT_SIZE];
+    uint16_t size;
+    uint16_t bytes;                     // EEPROM bytes in the chunk
+    volatile uint8_t state;
+} dumpBuffer;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// While uDMA sends one buffer the next chunk is read from the EEPROM and
+// formatted into the other. dumpFree counts the buffers uDMA is done with,
+// so its failed count is how often the reads got ahead of the UART.
+dumpBuffer dumpBuffers[2];
+semaphore dumpFree;
+uint8_t fillBuffer;
+uint8_t sendBuffer;
+
+// EEPROM data with room for the binary header and CRC around it
+#pragma DATA_ALIGN(dumpPacket, 4)
+uint8_t dumpPacket[DUMP_PACKET_SIZE];
+
+bool dumpRunning = false;
+uint8_t dumpFormat;
+uint32_t dumpStart;
+uint32_t dumpAddress;
+uint32_t dumpEnd;                       // one past the last byte
+uint32_t dumpStartTime;
+
+const char hexChars[] = "0123456789ABCDEF";
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+char* putHex(char* p, uint32_t value, uint8_t digits)
+{
+    while (digits--)
+        *p++ = hexChars[(value >> (digits * 4)) & 0xF];
+    return p;
+}
+
+char* putDecimal(char* p, uint32_t value)
+{
+    char digits[10];
+    uint8_t n = 0;
+    do
+    {
+        digits[n++] = '0' + value % 10;
+        value /= 10;
+    }
+    while (value);
+    while (n)
+        *p++ = digits[--n];
+    return p;
+}
+
+// Formats size bytes read from address into b
+void formatChunk(dumpBuffer* b, const uint8_t data[], uint32_t address, uint16_t size)
+{
+    dumpHeader* header = (dumpHeader*)dumpPacket;
+    char* p = b->text;
+    uint16_t i;
+    uint16_t crc;
+
+    if (dumpFormat == DUMP_BINARY)
+    {
+        header->type = STREAM_PACKET_DUMP;
+        header->reserved = 0;
+        header->size = size;
+        header->address = address;
+        crc = crc16(dumpPacket, sizeof(dumpHeader) + size, CRC16_INIT);
+        dumpPacket[sizeof(dumpHeader) + size] = crc;
+        dumpPacket[sizeof(dumpHeader) + size + 1] = crc >> 8;
+        b->size = cobsEncode(dumpPacket, sizeof(dumpHeader) + size + 2, (uint8_t*)b->text);
+        return;
+    }
+
+    for (i = 0; i < size; i++)
+    {
+        if (i % DUMP_BYTES_PER_LINE == 0)
+        {
+            if (dumpFormat == DUMP_HEX)
+            {
+                p = putHex(p, address + i, 4);
+                *p++ = ':';
+            }
+            else
+                p = putDecimal(p, address + i);
+        }
+        if (dumpFormat == DUMP_HEX)
+        {
+            *p++ = ' ';
+            p = putHex(p, data[i], 2);
+        }
+        else
+        {
+            *p++ = ',';
+            p = putDecimal(p, data[i]);
+        }
+        if (i % DUMP_BYTES_PER_LINE == DUMP_BYTES_PER_LINE - 1 || i == size - 1)
+        {
+            *p++ = '\r';
+            *p++ = '\n';
+        }
+    }
+    b->size = p - b->text;
+}
+
+// uDMA completion, called from the UART0 ISR
+void dumpChunkSent()
+{
+    dumpBuffers[sendBuffer].state = BUFFER_FREE;
+    sendBuffer ^= 1;
+    post(&dumpFree);
+}
+
+void initDump(void)
+{
+    dumpBuffers[0].state = BUFFER_FREE;
+    dumpBuffers[1].state = BUFFER_FREE;
+    initSemaphore(&dumpFree, "dumpFree", 2);
+}
+
+// Prints how much was sent and how fast
+void endDump()
+{
+    uint32_t elapsed = getTicks() - dumpStartTime;
+    dumpRunning = false;
+    if (elapsed == 0)
+        elapsed = 1;
+    printfUart0("\r\nDumped %d bytes in %d ms (%d B/s)\r\n", dumpAddress - dumpStart, elapsed,
+                (uint32_t)((uint64_t)(dumpAddress - dumpStart) * 1000 / elapsed));
+}
+
+bool startDump(uint32_t from, uint32_t to, uint8_t format)
+{
+    if (dumpRunning || from > to || to >= LOG_END)
+        return false;
+    dumpFormat = format;
+    dumpStart = from;
+    dumpAddress = from;
+    dumpEnd = to + 1;
+    fillBuffer = 0;
+    sendBuffer = 0;
+    dumpStartTime = getTicks();
+    dumpRunning = true;
+    if (format == DUMP_CSV)
+        putsUart0("address,data\r\n");
+    return true;
+}
+
+// Drops the chunks still waiting for uDMA and blocks until the one being
+// sent is out, so a dump can be started again right away (from a script)
+void stopDump(void)
+{
+    uint8_t i;
+    if (!dumpRunning)
+        return;
+    for (i = 0; i < 2; i++)
+    {
+        if (dumpBuffers[i].state == BUFFER_READY)
+        {
+            dumpBuffers[i].state = BUFFER_FREE;
+            dumpAddress -= dumpBuffers[i].bytes;
+            post(&dumpFree);
+        }
+    }
+    dumpEnd = dumpAddress;
+    // Both buffers are free once both can be taken, then they go back
+    wait(&dumpFree);
+    wait(&dumpFree);
+    post(&dumpFree);
+    post(&dumpFree);
+    endDump();
+}
+
+bool isDumpRunning(void)
+{
+    return dumpRunning;
+}
+
+// Polled while a dump runs, returns false once it has finished
+bool serviceDump(void)
+{
+    dumpBuffer* b;
+    uint16_t size;
+
+    if (!dumpRunning)
+        return false;
+
+    // Read and format the next chunk, up to the end of the EEPROM page
+    b = &dumpBuffers[fillBuffer];
+    if (dumpAddress < dumpEnd && tryWait(&dumpFree))
+    {
+        size = DUMP_CHUNK - (dumpAddress % DUMP_CHUNK);
+        if (size > dumpEnd - dumpAddress)
+            size = dumpEnd - dumpAddress;
+        readLog(dumpAddress, dumpPacket + sizeof(dumpHeader), size);
+        formatChunk(b, dumpPacket + sizeof(dumpHeader), dumpAddress, size);
+        b->bytes = size;
+        dumpAddress += size;
+        b->state = BUFFER_READY;
+        fillBuffer ^= 1;
+    }
+
+    // Hand the oldest formatted chunk to uDMA
+    b = &dumpBuffers[sendBuffer];
+    if (b->state == BUFFER_READY && !isUart0DmaBusy())
+    {
+        b->state = BUFFER_SENDING;
+        if (!writeUart0Dma(b->text, b->size, dumpChunkSent))
+            b->state = BUFFER_READY;
+    }
+
+    if (dumpAddress < dumpEnd || dumpBuffers[0].state != BUFFER_FREE ||
+        dumpBuffers[1].state != BUFFER_FREE)
+        return true;
+
+    endDump();
+    return false;
+}
@@ -0,0 +1,45 @@
+/*
+ * dump.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef DUMP_H_
+#define DUMP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DUMP_HEX            0
+#define DUMP_CSV            1
+#define DUMP_BINARY         2
+
+// EEPROM bytes per chunk, one page
+#define DUMP_CHUNK          128
+
+// Header of a binary dump packet, followed by the data and a CRC-16 of
+// both, COBS framed like the telemetry stream
+typedef struct _dumpHeader
+{
+    uint8_t type;                       // STREAM_PACKET_DUMP
+    uint8_t reserved;
+    uint16_t size;
+    uint32_t address;
+} dumpHeader;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initDump(void);
+bool startDump(uint32_t from, uint32_t to, uint8_t format);
+void stopDump(void);
+bool serviceDump(void);
+bool isDumpRunning(void);
+
+#endif
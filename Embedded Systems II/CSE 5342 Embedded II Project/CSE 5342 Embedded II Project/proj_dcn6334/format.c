@@ -0,0 +1,182 @@
+/*
+ * format.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include "uart0.h"
+#include "format.h"
+
+// 10 digits, the point and up to 9 leading zeros of a fixed-point fraction
+#define MAX_DIGITS          20
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const char hexDigits[] = "0123456789abcdef0123456789ABCDEF";
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void putPadding(char c, int16_t count)
+{
+    while (count-- > 0)
+        putcUart0(c);
+}
+
+// Digits are generated backwards into a small buffer, the sign and padding go
+// straight out
+void putNumber(uint32_t value, bool negative, uint8_t base, bool upper, uint8_t decimals,
+               uint8_t width, bool left, bool zero)
+{
+    char digits[MAX_DIGITS];
+    const char* set = hexDigits + (upper ? 16 : 0);
+    uint8_t n = 0;
+    int16_t pad;
+
+    if (decimals > 9)
+        decimals = 9;
+    do
+    {
+        if (decimals && n == decimals)
+            digits[n++] = '.';
+        digits[n++] = set[value % base];
+        value /= base;
+    }
+    while (value || n <= decimals);
+
+    pad = width - n - (negative ? 1 : 0);
+    if (!left && !zero)
+        putPadding(' ', pad);
+    if (negative)
+        putcUart0('-');
+    if (!left && zero)
+        putPadding('0', pad);
+    while (n)
+        putcUart0(digits[--n]);
+    if (left)
+        putPadding(' ', pad);
+}
+
+void vprintfUart0(const char format[], va_list args)
+{
+    bool left, zero, upper;
+    uint8_t width, decimals, length;
+    int32_t value;
+    const char* s;
+    char c;
+
+    while ((c = *format++) != 0)
+    {
+        if (c != '%')
+        {
+            putcUart0(c);
+            continue;
+        }
+
+        // Flags, width, precision and length
+        left = false;
+        zero = false;
+        width = 0;
+        decimals = 0;
+        length = 0;
+        for (;; format++)
+        {
+            if (*format == '-')
+                left = true;
+            else if (*format == '0')
+                zero = true;
+            else
+                break;
+        }
+        while (*format >= '0' && *format <= '9')
+            width = width * 10 + (*format++ - '0');
+        if (*format == '.')
+        {
+            format++;
+            while (*format >= '0' && *format <= '9')
+                decimals = decimals * 10 + (*format++ - '0');
+        }
+        while (*format == 'h')
+        {
+            length++;
+            format++;
+        }
+        if (*format == 'l')
+            format++;
+
+        c = *format++;
+        upper = false;
+        switch (c)
+        {
+        case 'd':
+        case 'i':
+            value = va_arg(args, int32_t);
+            if (length == 1)
+                value = (int16_t)value;
+            else if (length >= 2)
+                value = (int8_t)value;
+            putNumber(value < 0 ? 0u - (uint32_t)value : (uint32_t)value, value < 0, 10, false, 0,
+                      width, left, zero);
+            break;
+        case 'k':
+            value = va_arg(args, int32_t);
+            putNumber(value < 0 ? 0u - (uint32_t)value : (uint32_t)value, value < 0, 10, false,
+                      decimals, width, left, zero);
+            break;
+        case 'X':
+            upper = true;
+            // fall through
+        case 'u':
+        case 'x':
+            value = va_arg(args, uint32_t);
+            if (length == 1)
+                value = (uint16_t)value;
+            else if (length >= 2)
+                value = (uint8_t)value;
+            putNumber(value, false, (c == 'u') ? 10 : 16, upper, 0, width, left, zero);
+            break;
+        case 'c':
+            putPadding(' ', left ? 0 : width - 1);
+            putcUart0((char)va_arg(args, int));
+            putPadding(' ', left ? width - 1 : 0);
+            break;
+        case 's':
+            s = va_arg(args, const char*);
+            if (s == 0)
+                s = "(null)";
+            for (length = 0; s[length] && length < 255; length++);
+            if (!left)
+                putPadding(' ', width - length);
+            putsUart0(s);
+            if (left)
+                putPadding(' ', width - length);
+            break;
+        case '%':
+            putcUart0('%');
+            break;
+        default:
+            // Unknown conversion (%f included), stop rather than guess at the
+            // arguments
+            return;
+        }
+    }
+}
+
+void printfUart0(const char format[], ...)
+{
+    va_list args;
+    va_start(args, format);
+    vprintfUart0(format, args);
+    va_end(args);
+}
@@ -0,0 +1,35 @@
+/*
+ * format.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef FORMAT_H_
+#define FORMAT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdarg.h>
+
+// printf subset written straight into the UART0 TX ring:
+//   %d %i %u %x %X %c %s %%, with the flags '-' and '0', a width, and the
+//   length modifiers h, hh and l
+//   %.Nk prints an int32_t holding a fixed-point value with N decimals,
+//   e.g. ("%.2k", 1234) prints 12.34
+// There is no floating point: %f (and any other conversion) ends the output
+// there, so a double passed by mistake shows up as a cut-off line rather than
+// as a wrong number.
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void printfUart0(const char format[], ...);
+void vprintfUart0(const char format[], va_list args);
+
+#endif
@@ -21,6 +21,7 @@
 #include "tm4c123gh6pm.h"
 #include "gpio.h"
 #include "i2c0.h"
+#include "kernel.h"
 
 // PortB masks
 #define SDA_MASK 8
@@ -34,6 +35,9 @@
 // Global variables
 //-----------------------------------------------------------------------------
 
+// The MPU9250 and the 24LC512 share the bus, every transaction holds this
+mutex i2c0Mutex;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -41,6 +45,7 @@
 void initI2c0(void)
 {
     // Enable clocks
+    initMutex(&i2c0Mutex, "i2c0");
     SYSCTL_RCGCI2C_R |= SYSCTL_RCGCI2C_R0;
     _delay_cycles(3);
     enablePort(PORTB);
@@ -58,28 +63,56 @@ void initI2c0(void)
     I2C0_MCS_R = I2C_MCS_STOP;
 }
 
+// SCL period is 20 x (TPR + 1) system clocks, TPR is 7 bits so the slowest
+// rate is about 16 kbps (initI2c0's 199 leaves TPR = 71)
+void setI2c0Speed(uint16_t kbps)
+{
+    uint32_t tpr;
+    if (kbps == 0)
+        return;
+    tpr = (2000 + kbps / 2) / kbps;
+    tpr = (tpr == 0) ? 0 : tpr - 1;
+    if (tpr > I2C_MTPR_TPR_M)
+        tpr = I2C_MTPR_TPR_M;
+    lock(&i2c0Mutex);
+    I2C0_MTPR_R = tpr;
+    unlock(&i2c0Mutex);
+}
+
+uint16_t getI2c0Speed(void)
+{
+    return 2000 / ((I2C0_MTPR_R & I2C_MTPR_TPR_M) + 1);
+}
+
 // For simple devices with a single internal register
 void writeI2c0Data(uint8_t add, uint8_t data)
 {
+    lock(&i2c0Mutex);
     I2C0_MSA_R = add << 1; // add:r/~w=0
     I2C0_MDR_R = data;
     I2C0_MICR_R = I2C_MICR_IC;
     I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
     while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    unlock(&i2c0Mutex);
 }
 
 uint8_t readI2c0Data(uint8_t add)
 {
+    uint8_t result;
+    lock(&i2c0Mutex);
     I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
     I2C0_MICR_R = I2C_MICR_IC;
     I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
     while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return I2C0_MDR_R;
+    result = I2C0_MDR_R;
+    unlock(&i2c0Mutex);
+    return result;
 }
 
 // For devices with multiple registers
 void writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data)
 {
+    lock(&i2c0Mutex);
     I2C0_MSA_R = add << 1; // add:r/~w=0
     I2C0_MDR_R = reg;
     I2C0_MICR_R = I2C_MICR_IC;
@@ -89,11 +122,13 @@ void writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data)
     I2C0_MICR_R = I2C_MICR_IC;
     I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
     while (!(I2C0_MRIS_R & I2C_MRIS_RIS));
+    unlock(&i2c0Mutex);
 }
 
 void writeI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size)
 {
     uint8_t i;
+    lock(&i2c0Mutex);
     I2C0_MSA_R = add << 1; // add:r/~w=0
     I2C0_MDR_R = reg;
     if (size == 0)
@@ -119,10 +154,13 @@ void writeI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size)
         I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
         while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
     }
+    unlock(&i2c0Mutex);
 }
 
 uint8_t readI2c0Register(uint8_t add, uint8_t reg)
 {
+    uint8_t result;
+    lock(&i2c0Mutex);
     I2C0_MSA_R = add << 1; // add:r/~w=0
     I2C0_MDR_R = reg;
     I2C0_MICR_R = I2C_MICR_IC;
@@ -132,16 +170,117 @@ uint8_t readI2c0Register(uint8_t add, uint8_t reg)
     I2C0_MICR_R = I2C_MICR_IC;
     I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
     while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return I2C0_MDR_R;
+    result = I2C0_MDR_R;
+    unlock(&i2c0Mutex);
+    return result;
+}
+
+// For devices with a 16-bit register address (24LC512)
+uint8_t readI2c0Register16(uint8_t add, uint16_t reg)
+{
+    uint8_t result;
+    lock(&i2c0Mutex);
+    I2C0_MSA_R = add << 1; // add:r/~w=0
+    I2C0_MDR_R = (reg >> 8) & 0xFF;
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    I2C0_MDR_R = reg & 0xFF;
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_RUN;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    result = I2C0_MDR_R;
+    unlock(&i2c0Mutex);
+    return result;
+}
+
+// Sequential read starting at a 16-bit register address
+void readI2c0Registers16(uint8_t add, uint16_t reg, uint8_t data[], uint16_t size)
+{
+    uint16_t i;
+    if (size == 0)
+        return;
+    lock(&i2c0Mutex);
+    I2C0_MSA_R = add << 1; // add:r/~w=0
+    I2C0_MDR_R = (reg >> 8) & 0xFF;
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    I2C0_MDR_R = reg & 0xFF;
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_RUN;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
+    I2C0_MICR_R = I2C_MICR_IC;
+    if (size == 1)
+        I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
+    else
+        I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_ACK;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    for (i = 1; i < size; i++)
+    {
+        data[i-1] = I2C0_MDR_R;
+        I2C0_MICR_R = I2C_MICR_IC;
+        if (i == size-1)
+            I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;  // NACK the last byte
+        else
+            I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_ACK;
+        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    }
+    data[size-1] = I2C0_MDR_R;
+    unlock(&i2c0Mutex);
+}
+
+// Page write starting at a 16-bit register address
+void writeI2c0Registers16(uint8_t add, uint16_t reg, const uint8_t data[], uint16_t size)
+{
+    uint16_t i;
+    lock(&i2c0Mutex);
+    I2C0_MSA_R = add << 1; // add:r/~w=0
+    I2C0_MDR_R = (reg >> 8) & 0xFF;
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    I2C0_MDR_R = reg & 0xFF;
+    I2C0_MICR_R = I2C_MICR_IC;
+    if (size == 0)
+    {
+        I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
+        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+        unlock(&i2c0Mutex);
+        return;
+    }
+    I2C0_MCS_R = I2C_MCS_RUN;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    for (i = 0; i < size-1; i++)
+    {
+        I2C0_MDR_R = data[i];
+        I2C0_MICR_R = I2C_MICR_IC;
+        I2C0_MCS_R = I2C_MCS_RUN;
+        while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    }
+    I2C0_MDR_R = data[size-1];
+    I2C0_MICR_R = I2C_MICR_IC;
+    I2C0_MCS_R = I2C_MCS_RUN | I2C_MCS_STOP;
+    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
+    unlock(&i2c0Mutex);
 }
 
 bool pollI2c0Address(uint8_t add)
 {
+    bool result;
+    lock(&i2c0Mutex);
     I2C0_MSA_R = (add << 1) | 1; // add:r/~w=1
     I2C0_MICR_R = I2C_MICR_IC;
     I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
     while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return !(I2C0_MCS_R & I2C_MCS_ERROR);
+    result = !(I2C0_MCS_R & I2C_MCS_ERROR);
+    unlock(&i2c0Mutex);
+    return result;
 }
 
 bool isI2c0Error(void)
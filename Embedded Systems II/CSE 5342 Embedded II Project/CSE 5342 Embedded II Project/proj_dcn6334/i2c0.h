@@ -27,6 +27,8 @@
 //-----------------------------------------------------------------------------
 
 void initI2c0(void);
+void setI2c0Speed(uint16_t kbps);
+uint16_t getI2c0Speed(void);
 // For simple devices with a single internal register
 void writeI2c0Data(uint8_t add, uint8_t data);
 uint8_t readI2c0Data(uint8_t add);
@@ -34,6 +36,10 @@ uint8_t readI2c0Data(uint8_t add);
 void writeI2c0Register(uint8_t add, uint8_t reg, uint8_t data);
 void writeI2c0Registers(uint8_t add, uint8_t reg, uint8_t data[], uint8_t size);
 uint8_t readI2c0Register(uint8_t add, uint8_t reg);
+// For devices with a 16-bit register address
+uint8_t readI2c0Register16(uint8_t add, uint16_t reg);
+void readI2c0Registers16(uint8_t add, uint16_t reg, uint8_t data[], uint16_t size);
+void writeI2c0Registers16(uint8_t add, uint16_t reg, const uint8_t data[], uint16_t size);
 bool pollI2c0Address(uint8_t add);
 bool isI2c0Error(void);
 
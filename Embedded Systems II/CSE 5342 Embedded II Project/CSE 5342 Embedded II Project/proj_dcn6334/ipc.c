@@ -0,0 +1,183 @@
+/*
+ * ipc.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "kernel.h"
+#include "ipc.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+ipcObject* ipcObjects = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initIpcObject(ipcObject* o, const char name[], uint8_t type)
+{
+    o->name = name;
+    o->type = type;
+    o->waiters = 0;
+    o->highWater = 0;
+    o->waits = 0;
+    o->failed = 0;
+    o->next = ipcObjects;
+    ipcObjects = o;
+}
+
+// Called with interrupts disabled, returns with them disabled again once
+// the thread has been woken
+uint32_t blockOn(ipcObject* o, uint32_t key)
+{
+    o->waits++;
+    blockThread(&o->waiters);
+    _restore_interrupts(key);
+    yield();
+    return _disable_interrupts();
+}
+
+void initQueue(queue* q, const char name[], uint8_t size)
+{
+    q->size = (size > MAX_QUEUE_SIZE) ? MAX_QUEUE_SIZE : size;
+    q->head = 0;
+    q->count = 0;
+    initIpcObject(&q->header, name, IPC_QUEUE);
+}
+
+void enqueue(queue* q, void* msg)
+{
+    uint8_t tail = q->head + q->count;
+    if (tail >= q->size)
+        tail -= q->size;
+    q->slots[tail] = msg;
+    q->count++;
+    if (q->count > q->header.highWater)
+        q->header.highWater = q->count;
+}
+
+void* dequeue(queue* q)
+{
+    void* msg = q->slots[q->head];
+    if (++q->head == q->size)
+        q->head = 0;
+    q->count--;
+    return msg;
+}
+
+bool trySend(queue* q, void* msg)
+{
+    uint32_t key = _disable_interrupts();
+    if (q->count == q->size)
+    {
+        q->header.failed++;
+        _restore_interrupts(key);
+        return false;
+    }
+    enqueue(q, msg);
+    _restore_interrupts(key);
+    return true;
+}
+
+bool tryReceive(queue* q, void** msg)
+{
+    uint32_t key = _disable_interrupts();
+    if (q->count == 0)
+    {
+        _restore_interrupts(key);
+        return false;
+    }
+    *msg = dequeue(q);
+    _restore_interrupts(key);
+    return true;
+}
+
+void initSemaphore(semaphore* s, const char name[], uint16_t count)
+{
+    s->count = count;
+    initIpcObject(&s->header, name, IPC_SEMAPHORE);
+    s->header.highWater = count;
+}
+
+// Blocks while the count is 0
+void wait(semaphore* s)
+{
+    uint32_t key = _disable_interrupts();
+    while (s->count == 0)
+        key = blockOn(&s->header, key);
+    s->count--;
+    _restore_interrupts(key);
+}
+
+bool tryWait(semaphore* s)
+{
+    bool ok;
+    uint32_t key = _disable_interrupts();
+    ok = s->count > 0;
+    if (ok)
+        s->count--;
+    else
+        s->header.failed++;
+    _restore_interrupts(key);
+    return ok;
+}
+
+// Safe to call from an ISR
+void post(semaphore* s)
+{
+    bool higher = false;
+    uint32_t key = _disable_interrupts();
+    s->count++;
+    if (s->count > s->header.highWater)
+        s->header.highWater = s->count;
+    if (s->header.waiters)
+        higher = wakeThreads(&s->header.waiters, false);
+    _restore_interrupts(key);
+    if (higher)
+        yield();
+}
+
+void initEventGroup(eventGroup* e, const char name[])
+{
+    e->bits = 0;
+    initIpcObject(&e->header, name, IPC_EVENTS);
+}
+
+// Safe to call from an ISR
+void setEventBits(eventGroup* e, uint32_t bits)
+{
+    uint32_t key = _disable_interrupts();
+    e->bits |= bits;
+    _restore_interrupts(key);
+}
+
+// Returns any (or all) of bits that are set, or 0, and optionally clears
+// them. Polling is the normal use for tasks, so an empty poll is not
+// counted as failed.
+uint32_t tryWaitEventBits(eventGroup* e, uint32_t bits, bool all, bool clear)
+{
+    uint32_t set;
+    uint32_t key = _disable_interrupts();
+    set = e->bits & bits;
+    if (all ? (set != bits) : (set == 0))
+        set = 0;
+    else if (clear)
+        e->bits &= ~set;
+    _restore_interrupts(key);
+    return set;
+}
+
+ipcObject* getIpcList(void)
+{
+    return ipcObjects;
+}
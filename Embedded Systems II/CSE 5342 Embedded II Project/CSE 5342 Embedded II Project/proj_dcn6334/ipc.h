@@ -0,0 +1,80 @@
+/*
+ * ipc.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef IPC_H_
+#define IPC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAX_QUEUE_SIZE      16
+
+// Object types
+#define IPC_QUEUE           0
+#define IPC_SEMAPHORE       1
+#define IPC_EVENTS          2
+
+// Common part of every object, linked into the list shown by ipcs
+typedef struct _ipcObject
+{
+    const char* name;
+    uint8_t type;
+    uint8_t waiters;                    // one bit per blocked pid
+    uint16_t highWater;
+    uint32_t waits;                     // times a thread had to block
+    uint32_t failed;                    // try calls that could not complete
+    struct _ipcObject* next;
+} ipcObject;
+
+// Passes pointers, so a message is never copied
+typedef struct _queue
+{
+    ipcObject header;
+    void* slots[MAX_QUEUE_SIZE];
+    uint8_t size;
+    uint8_t head;
+    uint8_t count;
+} queue;
+
+typedef struct _semaphore
+{
+    ipcObject header;
+    uint16_t count;
+} semaphore;
+
+typedef struct _eventGroup
+{
+    ipcObject header;
+    uint32_t bits;
+} eventGroup;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// wait blocks and is for kernel threads only, tasks and ISRs use the try
+// calls
+void initQueue(queue* q, const char name[], uint8_t size);
+bool trySend(queue* q, void* msg);
+bool tryReceive(queue* q, void** msg);
+
+void initSemaphore(semaphore* s, const char name[], uint16_t count);
+void wait(semaphore* s);
+bool tryWait(semaphore* s);
+void post(semaphore* s);
+
+void initEventGroup(eventGroup* e, const char name[]);
+void setEventBits(eventGroup* e, uint32_t bits);
+uint32_t tryWaitEventBits(eventGroup* e, uint32_t bits, bool all, bool clear);
+
+ipcObject* getIpcList(void);
+
+#endif
@@ -0,0 +1,583 @@
+/*
+ * kernel.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// PendSV switches threads, SysTick drives sleep and time slicing
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "scheduler.h"
+#include "profile.h"
+#include "kernel.h"
+
+#define IDLE_THREAD         0
+#define IDLE_STACK_SIZE     256
+#define MIN_STACK_SIZE      128
+
+// Unused stack is filled with this so the high-water mark can be found
+#define STACK_PAINT         0xA5A5A5A5
+// Words below the current SP left alone when the main stack is painted
+#define PAINT_MARGIN        16
+
+// Thread mode, PSP, no FPU context
+#define EXC_RETURN_THREAD   0xFFFFFFFD
+#define XPSR_THUMB          0x01000000
+
+typedef struct _thread
+{
+    char name[THREAD_NAME_SIZE];
+    uint32_t* sp;
+    uint32_t* stackBase;                // lowest address of the stack
+    uint16_t stackSize;
+    uint8_t state;
+    uint8_t priority;
+    uint8_t currentPriority;
+    uint32_t delay;                     // ms left while delayed
+    uint32_t cpuCycles;
+    mutex* blockedOn;
+    uint32_t blockStart;
+    uint32_t maxBlocked;
+} thread;
+
+// In kernelasm.asm
+extern void setPsp(uint32_t* sp);
+extern void usePsp(void);
+extern uint32_t* getSp(void);
+
+// Main (MSP) stack from the linker
+extern uint32_t __stack;
+extern uint32_t __STACK_END;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+thread threads[MAX_THREADS];
+uint8_t threadCount = 0;
+uint8_t currentThread = IDLE_THREAD;
+bool kernelRunning = false;
+bool prioritySched = true;
+bool preemption = false;
+bool priorityInheritance = true;
+uint32_t lastSwitch = 0;
+
+// Thread stacks are carved out of this pool, 8-byte aligned
+uint64_t stackPool[KERNEL_STACK_POOL / 8];
+uint16_t stackPoolUsed = 0;
+
+// Every mutex, for priority recalculation and ipcs
+mutex* mutexes = 0;
+
+// Thread mode runs on this until the first switch discards it
+uint32_t startStack[32];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Runs when nothing else is ready
+void idleThread()
+{
+    while (true)
+        __asm("    WFI");
+}
+
+// A thread that returns from its function ends here
+void threadExit()
+{
+    threads[currentThread].state = STATE_KILLED;
+    yield();
+    while (true);
+}
+
+// Called from the SysTick handler with the ms that passed
+void kernelTick(uint32_t ms)
+{
+    uint8_t i;
+    for (i = 0; i < threadCount; i++)
+    {
+        if (threads[i].state == STATE_DELAYED)
+        {
+            if (threads[i].delay <= ms)
+                threads[i].state = STATE_READY;
+            else
+                threads[i].delay -= ms;
+        }
+    }
+    // Time slice
+    if (kernelRunning && preemption)
+        NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV;
+}
+
+// Paints the main stack below the caller, call first thing in main
+void paintMainStack(void)
+{
+    uint32_t* p;
+    uint32_t* end = getSp() - PAINT_MARGIN;
+    for (p = &__stack; p < end; p++)
+        *p = STACK_PAINT;
+}
+
+// Bytes of a stack that were ever used, found from the painted words left
+// at the bottom
+uint32_t getStackUsed(uint32_t* base, uint32_t* end)
+{
+    uint32_t* p = base;
+    while (p < end && *p == STACK_PAINT)
+        p++;
+    return (end - p) * 4;
+}
+
+uint32_t getMainStackUsed(void)
+{
+    return getStackUsed(&__stack, &__STACK_END);
+}
+
+uint32_t getMainStackSize(void)
+{
+    return (&__STACK_END - &__stack) * 4;
+}
+
+uint32_t getStackPoolUsed(void)
+{
+    return stackPoolUsed;
+}
+
+void initKernel(void)
+{
+    threadCount = 0;
+    stackPoolUsed = 0;
+    kernelRunning = false;
+    createThread(idleThread, "idle", PRIORITY_LOWEST, IDLE_STACK_SIZE);
+
+    // CPU time is measured with the DWT cycle counter
+    NVIC_DBG_INT_R |= NVIC_DBG_INT_TRCENA;
+    DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+}
+
+// Builds the frame that the first switch to the thread pops, returns the
+// pid or -1 if the table or the stack pool is full
+int8_t createThread(_fn fn, const char name[], uint8_t priority, uint16_t stackBytes)
+{
+    thread* t;
+    uint32_t* sp;
+    uint8_t i;
+    uint32_t key;
+
+    stackBytes = (stackBytes + 7) & ~7;
+    if (priority > PRIORITY_LOWEST || stackBytes < MIN_STACK_SIZE)
+        return -1;
+    key = _disable_interrupts();
+    if (threadCount >= MAX_THREADS || stackPoolUsed + stackBytes > KERNEL_STACK_POOL)
+    {
+        _restore_interrupts(key);
+        return -1;
+    }
+    t = &threads[threadCount];
+    for (i = 0; i < THREAD_NAME_SIZE - 1 && name[i] != '\0'; i++)
+        t->name[i] = name[i];
+    t->name[i] = '\0';
+    t->stackBase = (uint32_t*)((uint8_t*)stackPool + stackPoolUsed);
+    t->stackSize = stackBytes;
+    stackPoolUsed += stackBytes;
+    for (sp = t->stackBase; sp < t->stackBase + stackBytes / 4; sp++)
+        *sp = STACK_PAINT;
+
+    // Exception frame
+    sp = t->stackBase + stackBytes / 4;
+    *--sp = XPSR_THUMB;
+    *--sp = (uint32_t)fn;               // PC
+    *--sp = (uint32_t)threadExit;       // LR
+    for (i = 0; i < 5; i++)             // R12, R3-R0
+        *--sp = 0;
+    // Saved by pendSvIsr
+    *--sp = EXC_RETURN_THREAD;
+    for (i = 0; i < 8; i++)             // R11-R4
+        *--sp = 0;
+    t->sp = sp;
+
+    t->state = STATE_READY;
+    t->priority = priority;
+    t->currentPriority = priority;
+    t->delay = 0;
+    t->cpuCycles = 0;
+    t->blockedOn = 0;
+    t->maxBlocked = 0;
+    _restore_interrupts(key);
+    return threadCount++;
+}
+
+// Starts the first thread, does not return
+void startKernel(void)
+{
+    // PendSV below every interrupt so it never switches in the middle of
+    // an ISR, SysTick just above it
+    NVIC_SYS_PRI3_R = (NVIC_SYS_PRI3_R & ~(NVIC_SYS_PRI3_PENDSV_M | NVIC_SYS_PRI3_TICK_M))
+                    | (7 << NVIC_SYS_PRI3_PENDSV_S) | (6 << NVIC_SYS_PRI3_TICK_S);
+    setTickHook(kernelTick);
+    setPsp(startStack + 32);
+    usePsp();
+    NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV;
+    while (true);
+}
+
+bool isKernelRunning(void)
+{
+    return kernelRunning;
+}
+
+// Picks the next thread. Scanning starts after the current thread so threads
+// of equal priority (or all threads in round-robin) take turns. The idle
+// thread only runs if nothing else is ready.
+uint8_t nextThread()
+{
+    uint8_t i, t;
+    uint8_t best = IDLE_THREAD;
+    uint8_t bestPriority = 0xFF;
+    uint8_t priority;
+    for (i = 1; i <= threadCount; i++)
+    {
+        t = (currentThread + i) % threadCount;
+        if (t == IDLE_THREAD || threads[t].state != STATE_READY)
+            continue;
+        priority = prioritySched ? threads[t].currentPriority : 0;
+        if (priority < bestPriority)
+        {
+            bestPriority = priority;
+            best = t;
+        }
+    }
+    return best;
+}
+
+// Called from pendSvIsr with the stack pointer of the thread being left,
+// returns the stack pointer of the next one
+uint32_t* switchContext(uint32_t* sp)
+{
+    uint32_t now = DWT_CYCCNT_R;
+    if (kernelRunning)
+    {
+        threads[currentThread].sp = sp;
+        threads[currentThread].cpuCycles += now - lastSwitch;
+    }
+    kernelRunning = true;
+    lastSwitch = now;
+    currentThread = nextThread();
+    return threads[currentThread].sp;
+}
+
+void yield(void)
+{
+    if (kernelRunning)
+        NVIC_INT_CTRL_R = NVIC_INT_CTRL_PEND_SV;
+}
+
+void sleep(uint32_t ms)
+{
+    uint32_t key;
+    if (ms == 0)
+    {
+        yield();
+        return;
+    }
+    key = _disable_interrupts();
+    threads[currentThread].delay = ms;
+    threads[currentThread].state = STATE_DELAYED;
+    _restore_interrupts(key);
+    yield();
+}
+
+void initMutex(mutex* m, const char name[])
+{
+    m->name = name;
+    m->owner = -1;
+    m->waiters = 0;
+    m->locks = 0;
+    m->contended = 0;
+    m->next = mutexes;
+    mutexes = m;
+}
+
+// Raises the owner, and whatever it is blocked on in turn, to priority
+void inheritPriority(int8_t owner, uint8_t priority)
+{
+    while (owner >= 0 && threads[owner].currentPriority > priority)
+    {
+        threads[owner].currentPriority = priority;
+        owner = threads[owner].blockedOn ? threads[owner].blockedOn->owner : -1;
+    }
+}
+
+// Drops back to the base priority, or to the highest waiter on a mutex
+// the thread still holds
+void restorePriority(uint8_t pid)
+{
+    mutex* m;
+    uint8_t i;
+    uint8_t priority = threads[pid].priority;
+    if (priorityInheritance)
+    {
+        for (m = mutexes; m != 0; m = m->next)
+        {
+            if (m->owner != pid)
+                continue;
+            for (i = 0; i < threadCount; i++)
+            {
+                if ((m->waiters & (1 << i)) && threads[i].currentPriority < priority)
+                    priority = threads[i].currentPriority;
+            }
+        }
+    }
+    threads[pid].currentPriority = priority;
+}
+
+// Hands the mutex to the highest priority waiter, returns its pid or -1
+int8_t releaseMutex(mutex* m)
+{
+    int8_t best = -1;
+    uint8_t i;
+    uint32_t blocked;
+    for (i = 0; i < threadCount; i++)
+    {
+        if ((m->waiters & (1 << i)) && (best < 0 || threads[i].currentPriority < threads[best].currentPriority))
+            best = i;
+    }
+    m->owner = best;
+    if (best >= 0)
+    {
+        m->waiters &= ~(1 << best);
+        m->locks++;
+        blocked = DWT_CYCCNT_R - threads[best].blockStart;
+        if (blocked > threads[best].maxBlocked)
+            threads[best].maxBlocked = blocked;
+        threads[best].blockedOn = 0;
+        threads[best].state = STATE_READY;
+    }
+    return best;
+}
+
+// Does nothing before the kernel starts, and must not be called from an ISR
+// or with interrupts masked
+void lock(mutex* m)
+{
+    uint32_t key;
+    thread* t;
+    if (!kernelRunning)
+        return;
+    key = _disable_interrupts();
+    if (m->owner < 0)
+    {
+        m->owner = currentThread;
+        m->locks++;
+        _restore_interrupts(key);
+        return;
+    }
+    t = &threads[currentThread];
+    m->contended++;
+    m->waiters |= 1 << currentThread;
+    t->blockedOn = m;
+    t->blockStart = DWT_CYCCNT_R;
+    t->state = STATE_BLOCKED;
+    if (priorityInheritance)
+        inheritPriority(m->owner, t->currentPriority);
+    _restore_interrupts(key);
+    // Returns once unlock has handed over the mutex
+    yield();
+}
+
+void unlock(mutex* m)
+{
+    uint32_t key;
+    int8_t next;
+    bool higher;
+    if (!kernelRunning)
+        return;
+    key = _disable_interrupts();
+    if (m->owner != currentThread)
+    {
+        _restore_interrupts(key);
+        return;
+    }
+    next = releaseMutex(m);
+    restorePriority(currentThread);
+    higher = next >= 0 && threads[next].currentPriority < threads[currentThread].currentPriority;
+    _restore_interrupts(key);
+    if (higher)
+        yield();
+}
+
+mutex* getMutexList(void)
+{
+    return mutexes;
+}
+
+// For the IPC objects, called with interrupts disabled. The calling thread
+// is marked blocked in waiters and stops at its next yield.
+void blockThread(uint8_t* waiters)
+{
+    *waiters |= 1 << currentThread;
+    threads[currentThread].state = STATE_BLOCKED;
+}
+
+// Called with interrupts disabled. Readies the highest priority thread in
+// waiters, or all of them, and returns true if one outranks the caller.
+bool wakeThreads(uint8_t* waiters, bool all)
+{
+    int8_t best = -1;
+    uint8_t i;
+    bool higher = false;
+    for (i = 0; i < threadCount; i++)
+    {
+        if (!(*waiters & (1 << i)))
+            continue;
+        if (threads[i].state != STATE_BLOCKED)
+            *waiters &= ~(1 << i);
+        else if (all)
+        {
+            *waiters &= ~(1 << i);
+            threads[i].state = STATE_READY;
+            higher |= threads[i].currentPriority < threads[currentThread].currentPriority;
+        }
+        else if (best < 0 || threads[i].currentPriority < threads[best].currentPriority)
+            best = i;
+    }
+    if (best >= 0)
+    {
+        *waiters &= ~(1 << best);
+        threads[best].state = STATE_READY;
+        higher = threads[best].currentPriority < threads[currentThread].currentPriority;
+    }
+    return higher;
+}
+
+void setPriorityInheritance(bool on)
+{
+    uint8_t i;
+    priorityInheritance = on;
+    for (i = 0; i < threadCount; i++)
+        restorePriority(i);
+}
+
+// The idle thread and the calling thread cannot be killed. Mutexes the
+// thread holds are passed on to their waiters.
+bool killThread(int8_t pid)
+{
+    mutex* m;
+    uint32_t key;
+    uint8_t i;
+    if (pid <= IDLE_THREAD || pid >= threadCount || pid == currentThread ||
+        threads[pid].state == STATE_KILLED)
+        return false;
+    key = _disable_interrupts();
+    threads[pid].state = STATE_KILLED;
+    threads[pid].blockedOn = 0;
+    for (m = mutexes; m != 0; m = m->next)
+    {
+        m->waiters &= ~(1 << pid);
+        if (m->owner == pid)
+            releaseMutex(m);
+    }
+    for (i = 0; i < threadCount; i++)
+        restorePriority(i);
+    _restore_interrupts(key);
+    return true;
+}
+
+int8_t getPid(const char name[])
+{
+    uint8_t i, j;
+    for (i = 0; i < threadCount; i++)
+    {
+        for (j = 0; j < THREAD_NAME_SIZE && name[j] == threads[i].name[j] && name[j] != '\0'; j++);
+        if (j < THREAD_NAME_SIZE && name[j] == threads[i].name[j])
+            return i;
+    }
+    return -1;
+}
+
+int8_t getCurrentPid(void)
+{
+    return currentThread;
+}
+
+uint8_t getThreadCount(void)
+{
+    return threadCount;
+}
+
+bool getThreadInfo(int8_t pid, threadInfo* info)
+{
+    if (pid < 0 || pid >= threadCount)
+        return false;
+    info->name = threads[pid].name;
+    info->priority = threads[pid].priority;
+    info->currentPriority = threads[pid].currentPriority;
+    info->state = threads[pid].state;
+    info->cpuCycles = threads[pid].cpuCycles;
+    info->maxBlocked = threads[pid].maxBlocked;
+    info->stackSize = threads[pid].stackSize;
+    info->stackUsed = getStackUsed(threads[pid].stackBase, threads[pid].stackBase + threads[pid].stackSize / 4);
+    return true;
+}
+
+void resetThreadCpu(void)
+{
+    uint8_t i;
+    uint32_t key = _disable_interrupts();
+    for (i = 0; i < threadCount; i++)
+        threads[i].cpuCycles = 0;
+    _restore_interrupts(key);
+}
+
+void setPriorityScheduling(bool on)
+{
+    prioritySched = on;
+}
+
+void setPreemption(bool on)
+{
+    preemption = on;
+}
+
+// True if a thread other than the caller and the idle thread could run
+bool isThreadReady(void)
+{
+    uint8_t i;
+    for (i = 0; i < threadCount; i++)
+    {
+        if (i != IDLE_THREAD && i != currentThread && threads[i].state == STATE_READY)
+            return true;
+    }
+    return false;
+}
+
+// ms until the first delayed thread wakes, 0 if another thread is ready
+uint32_t getKernelIdleTime(void)
+{
+    uint8_t i;
+    uint32_t idle = IDLE_FOREVER;
+    if (isThreadReady())
+        return 0;
+    for (i = 0; i < threadCount; i++)
+    {
+        if (threads[i].state == STATE_DELAYED && threads[i].delay < idle)
+            idle = threads[i].delay;
+    }
+    return idle;
+}
@@ -0,0 +1,101 @@
+/*
+ * kernel.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// PendSV switches threads, SysTick drives sleep and time slicing
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef KERNEL_H_
+#define KERNEL_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "scheduler.h"
+
+#define MAX_THREADS         8
+#define THREAD_NAME_SIZE    12
+#define KERNEL_STACK_POOL   8192        // bytes shared by all thread stacks
+
+// 0 is the highest priority
+#define PRIORITY_HIGHEST    0
+#define PRIORITY_LOWEST     7
+
+// Thread states
+#define STATE_INVALID       0
+#define STATE_READY         1
+#define STATE_DELAYED       2
+#define STATE_BLOCKED       3
+#define STATE_KILLED        4
+
+typedef struct _threadInfo
+{
+    const char* name;
+    uint8_t priority;
+    uint8_t currentPriority;
+    uint8_t state;
+    uint32_t cpuCycles;                 // since the last resetThreadCpu
+    uint32_t maxBlocked;                // longest wait for a mutex, cycles
+    uint16_t stackSize;
+    uint16_t stackUsed;                 // high-water mark in bytes
+} threadInfo;
+
+// Blocked threads are handed the mutex in priority order on unlock
+typedef struct _mutex
+{
+    const char* name;
+    int8_t owner;                       // -1 when free
+    uint8_t waiters;                    // one bit per pid
+    uint32_t locks;
+    uint32_t contended;
+    struct _mutex* next;
+} mutex;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void paintMainStack(void);
+uint32_t getMainStackUsed(void);
+uint32_t getMainStackSize(void);
+uint32_t getStackPoolUsed(void);
+void initKernel(void);
+int8_t createThread(_fn fn, const char name[], uint8_t priority, uint16_t stackBytes);
+void startKernel(void);
+bool isKernelRunning(void);
+void yield(void);
+void sleep(uint32_t ms);
+bool killThread(int8_t pid);
+int8_t getPid(const char name[]);
+int8_t getCurrentPid(void);
+uint8_t getThreadCount(void);
+bool getThreadInfo(int8_t pid, threadInfo* info);
+void resetThreadCpu(void);
+void setPriorityScheduling(bool on);
+void setPreemption(bool on);
+bool isThreadReady(void);
+uint32_t getKernelIdleTime(void);
+void initMutex(mutex* m, const char name[]);
+void lock(mutex* m);
+void unlock(mutex* m);
+void setPriorityInheritance(bool on);
+mutex* getMutexList(void);
+void blockThread(uint8_t* waiters);
+bool wakeThreads(uint8_t* waiters, bool all);
+uint32_t* switchContext(uint32_t* sp);
+void pendSvIsr(void);
+
+#endif
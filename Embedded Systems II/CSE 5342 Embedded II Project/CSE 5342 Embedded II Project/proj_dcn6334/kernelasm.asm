@@ -0,0 +1,67 @@
+; kernelasm.asm
+;
+;  Created on: Oct 19, 2026
+;      Author: dnwae
+
+;-----------------------------------------------------------------------------
+; Hardware Target
+;-----------------------------------------------------------------------------
+
+; Target uC:       TM4C123GH6PM
+; System Clock:    40 MHz
+
+;-----------------------------------------------------------------------------
+; Device includes, defines, and assembler directives
+;-----------------------------------------------------------------------------
+
+   .def pendSvIsr
+   .def setPsp
+   .def usePsp
+   .def getSp
+   .ref switchContext
+
+;-----------------------------------------------------------------------------
+; Subroutines
+;-----------------------------------------------------------------------------
+
+   .thumb
+   .text
+
+; The hardware has already pushed R0-R3, R12, LR, PC and xPSR (and S0-S15
+; if the thread used the FPU) on the PSP. Push the rest, let switchContext
+; pick the next thread and pop its context.
+pendSvIsr:
+               MRS    R0, PSP
+               TST    LR, #0x10              ; bit 4 clear = FPU context
+               IT     EQ
+               VSTMDBEQ R0!, {S16-S31}
+               STMDB  R0!, {R4-R11, LR}
+               CPSID  I
+               BL     switchContext          ; R0 = sp of the next thread
+               CPSIE  I
+               LDMIA  R0!, {R4-R11, LR}
+               TST    LR, #0x10
+               IT     EQ
+               VLDMIAEQ R0!, {S16-S31}
+               MSR    PSP, R0
+               BX     LR
+
+; void setPsp(uint32_t* sp)
+setPsp:
+               MSR    PSP, R0
+               BX     LR
+
+; Thread mode uses the PSP from here on
+usePsp:
+               MRS    R0, CONTROL
+               ORR    R0, R0, #2
+               MSR    CONTROL, R0
+               ISB
+               BX     LR
+
+; uint32_t* getSp(void)
+getSp:
+               MOV    R0, SP
+               BX     LR
+
+   .end
@@ -0,0 +1,179 @@
+/*
+ * power.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// SysTick is stretched to wake the core from sleep
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "scheduler.h"
+#include "kernel.h"
+#include "power.h"
+
+#define SYSTICK_ON  (NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN | NVIC_ST_CTRL_ENABLE)
+#define SYSTICK_OFF (NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+bool tickless = true;
+
+// Residency since the last reset
+uint32_t sleepCount = 0;
+uint64_t sleepCycles = 0;
+uint32_t residencyStart = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Only the wake sources keep their clocks while the core sleeps:
+// GPIO A (UART0 pins), GPIO F (PF4 trigger), UART0 and the hibernation
+// module, plus uDMA so a console transfer continues during sleep and ADC0
+// with Timer 0 so the sample sequence keeps being triggered
+void initPower(void)
+{
+    SYSCTL_SCGCGPIO_R = 0x21;
+    SYSCTL_SCGCUART_R = 0x01;
+    SYSCTL_SCGCHIB_R = 0x01;
+    SYSCTL_SCGCI2C_R = 0;
+    SYSCTL_SCGCADC_R = 0x01;
+    SYSCTL_SCGCEEPROM_R = 0;
+    SYSCTL_SCGCTIMER_R = 0x01;
+    SYSCTL_SCGCWTIMER_R = 0;
+    SYSCTL_SCGCDMA_R = 0x01;
+    SYSCTL_SCGCSSI_R = 0;
+
+    // Same set for deep sleep, which is not entered since SysTick keeps time
+    SYSCTL_DCGCGPIO_R = 0x21;
+    SYSCTL_DCGCUART_R = 0x01;
+    SYSCTL_DCGCHIB_R = 0x01;
+    SYSCTL_DCGCI2C_R = 0;
+    SYSCTL_DCGCADC_R = 0x01;
+    SYSCTL_DCGCEEPROM_R = 0;
+    SYSCTL_DCGCTIMER_R = 0x01;
+    SYSCTL_DCGCWTIMER_R = 0;
+    SYSCTL_DCGCDMA_R = 0x01;
+    SYSCTL_DCGCSSI_R = 0;
+
+    NVIC_SYS_CTRL_R &= ~NVIC_SYS_CTRL_SLEEPDEEP;
+    SYSCTL_RCC_R |= SYSCTL_RCC_ACG;
+    resetPowerStats();
+}
+
+// Sleeps until the next tick or interrupt
+void sleepOneTick()
+{
+    uint32_t current = NVIC_ST_CURRENT_R;
+    uint32_t now;
+    __asm("    WFI");
+    now = NVIC_ST_CURRENT_R;
+    sleepCycles += (current >= now) ? current - now : current + TICKS_PER_MS - now;
+}
+
+// Idle hook for the scheduler, runs with interrupts masked. SysTick is
+// reloaded to fire when the next task is due and the ticks that passed are
+// added back on wake.
+void lowPowerIdle(void)
+{
+    uint32_t idle = getIdleTime();
+    uint32_t kernelIdle = getKernelIdleTime();
+    uint32_t current, reload, now, elapsed, remaining;
+    bool expired;
+
+    // Sleeping kernel threads have deadlines too
+    if (kernelIdle < idle)
+        idle = kernelIdle;
+    if (idle == 0)
+        return;
+    if (idle > MAX_IDLE_MS)
+        idle = MAX_IDLE_MS;
+    sleepCount++;
+
+    if (!tickless || idle < 2)
+    {
+        sleepOneTick();
+        return;
+    }
+
+    NVIC_ST_CTRL_R = SYSTICK_OFF;
+    current = NVIC_ST_CURRENT_R;
+    // The tick is already due
+    if (current == 0 || (NVIC_INT_CTRL_R & NVIC_INT_CTRL_PENDSTSET))
+    {
+        NVIC_ST_CTRL_R = SYSTICK_ON;
+        return;
+    }
+
+    // The rest of this tick plus the whole ticks to the deadline
+    reload = current + (idle - 1) * TICKS_PER_MS;
+    NVIC_ST_RELOAD_R = reload;
+    NVIC_ST_CURRENT_R = 0;
+    NVIC_ST_CTRL_R = SYSTICK_ON;
+    __asm("    WFI");
+    expired = (NVIC_ST_CTRL_R & NVIC_ST_CTRL_COUNT) != 0;
+    NVIC_ST_CTRL_R = SYSTICK_OFF;
+    now = NVIC_ST_CURRENT_R;
+
+    // Cycles since the start of the tick the sleep began in
+    if (expired)
+    {
+        elapsed = idle * TICKS_PER_MS + (reload - now);
+        NVIC_INT_CTRL_R = NVIC_INT_CTRL_PENDSTCLR;
+    }
+    else
+        elapsed = TICKS_PER_MS - current + (reload - now);
+    sleepCycles += elapsed - (TICKS_PER_MS - current);
+    advanceTicks(elapsed / TICKS_PER_MS);
+
+    // Finish the partial tick, then go back to 1 ms
+    remaining = TICKS_PER_MS - elapsed % TICKS_PER_MS;
+    NVIC_ST_RELOAD_R = (remaining > 1) ? remaining - 1 : 1;
+    NVIC_ST_CURRENT_R = 0;
+    NVIC_ST_CTRL_R = SYSTICK_ON;
+    NVIC_ST_RELOAD_R = TICKS_PER_MS - 1;
+}
+
+void setTickless(bool on)
+{
+    tickless = on;
+}
+
+void resetPowerStats(void)
+{
+    sleepCount = 0;
+    sleepCycles = 0;
+    residencyStart = getTicks();
+}
+
+uint32_t getSleepCount(void)
+{
+    return sleepCount;
+}
+
+uint64_t getSleepCycles(void)
+{
+    return sleepCycles;
+}
+
+uint64_t getElapsedCycles(void)
+{
+    return (uint64_t)(getTicks() - residencyStart) * TICKS_PER_MS;
+}
@@ -0,0 +1,43 @@
+/*
+ * power.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// SysTick is stretched to wake the core from sleep
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef POWER_H_
+#define POWER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Longest sleep that fits the 24-bit SysTick reload at 40 MHz (419 ms)
+#define MAX_IDLE_MS 400
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initPower(void);
+void lowPowerIdle(void);
+void setTickless(bool on);
+void resetPowerStats(void);
+uint32_t getSleepCount(void);
+uint64_t getSleepCycles(void);
+uint64_t getElapsedCycles(void);
+
+#endif
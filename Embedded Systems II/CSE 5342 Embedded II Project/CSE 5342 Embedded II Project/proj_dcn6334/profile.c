@@ -0,0 +1,125 @@
+/*
+ * profile.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// DWT cycle counter (CYCCNT)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "uart0.h"
+#include "format.h"
+#include "profile.h"
+
+#define CYCLES_PER_US 40
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Regions that have run at least once, newest first
+profRegion* profRegions = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Starts the cycle counter, needs trace enabled in DEMCR first
+void initProfile(void)
+{
+#ifdef PROFILE
+    NVIC_DBG_INT_R |= NVIC_DBG_INT_TRCENA;
+    DWT_CYCCNT_R = 0;
+    DWT_CTRL_R |= DWT_CTRL_CYCCNTENA;
+#endif
+}
+
+void recordProfile(profRegion* region, uint32_t cycles)
+{
+    uint8_t bucket = 0;
+    uint32_t key;
+    // The acquisition thread can preempt a foreground region halfway through
+    // linking itself in, so the list is only changed with interrupts off
+    if (!region->registered)
+    {
+        key = _disable_interrupts();
+        if (!region->registered)
+        {
+            region->next = profRegions;
+            profRegions = region;
+            region->registered = true;
+        }
+        _restore_interrupts(key);
+    }
+    if (region->count == 0 || cycles < region->min)
+        region->min = cycles;
+    region->count++;
+    region->total += cycles;
+    if (cycles > region->max)
+        region->max = cycles;
+    while (cycles > 1 && bucket < PROF_BUCKETS - 1)
+    {
+        cycles >>= 1;
+        bucket++;
+    }
+    if (region->histogram[bucket] != 0xFFFF)
+        region->histogram[bucket]++;
+}
+
+// Clears the statistics, the regions stay registered
+void resetProfile(void)
+{
+    profRegion* region;
+    uint8_t i;
+    for (region = profRegions; region != 0; region = region->next)
+    {
+        region->count = 0;
+        region->total = 0;
+        region->min = 0;
+        region->max = 0;
+        for (i = 0; i < PROF_BUCKETS; i++)
+            region->histogram[i] = 0;
+    }
+}
+
+// Times are in cycles, with the average in us
+void printProfile(void)
+{
+#ifdef PROFILE
+    profRegion* region;
+    uint32_t average;
+    uint8_t i;
+    putsUart0("Region      Count     Avg us    Min cyc    Max cyc\r\n");
+    for (region = profRegions; region != 0; region = region->next)
+    {
+        average = region->count ? region->total / region->count : 0;
+        printfUart0("%-10s %6u %6u.%03u %10u %10u\r\n", region->name, region->count,
+                average / CYCLES_PER_US, (average % CYCLES_PER_US) * 1000 / CYCLES_PER_US,
+                region->min, region->max);
+        for (i = 0; i < PROF_BUCKETS; i++)
+        {
+            if (region->histogram[i])
+            {
+                printfUart0("    >= %8u cyc: %u\r\n", (uint32_t)1 << i, region->histogram[i]);
+            }
+        }
+    }
+#else
+    putsUart0("Profiling is compiled out\r\n");
+#endif
+}
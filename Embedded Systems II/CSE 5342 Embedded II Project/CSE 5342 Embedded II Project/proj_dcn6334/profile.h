@@ -0,0 +1,75 @@
+/*
+ * profile.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// DWT cycle counter (CYCCNT)
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// On unless the build defines NO_PROFILE (--define=NO_PROFILE), which
+// compiles the instrumentation out
+#ifndef NO_PROFILE
+#define PROFILE
+#endif
+
+// DWT registers are not in tm4c123gh6pm.h
+#define DWT_CTRL_R              (*((volatile uint32_t *)0xE0001000))
+#define DWT_CYCCNT_R            (*((volatile uint32_t *)0xE0001004))
+#define DWT_CTRL_CYCCNTENA      0x00000001
+#define NVIC_DBG_INT_TRCENA     0x01000000  // DEMCR trace enable
+
+// Bucket n counts durations of 2^n to 2^(n+1)-1 cycles, the last one
+// everything longer
+#define PROF_BUCKETS 24
+
+typedef struct _profRegion
+{
+    const char* name;
+    struct _profRegion* next;
+    bool registered;
+    uint32_t count;
+    uint64_t total;
+    uint32_t min;
+    uint32_t max;
+    uint16_t histogram[PROF_BUCKETS];
+} profRegion;
+
+// PROF_BEGIN(name) ... PROF_END wrap a block of code. The region registers
+// itself the first time it ends.
+#ifdef PROFILE
+#define PROF_BEGIN(region) { static profRegion profData = {#region}; uint32_t profStart = DWT_CYCCNT_R;
+#define PROF_END recordProfile(&profData, DWT_CYCCNT_R - profStart); }
+#else
+#define PROF_BEGIN(region) {
+#define PROF_END }
+#endif
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initProfile(void);
+void recordProfile(profRegion* region, uint32_t cycles);
+void resetProfile(void);
+void printProfile(void);
+
+#endif
@@ -6,7 +6,6 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include <stdio.h>
 #include "tm4c123gh6pm.h"
 #include "clock.h"
 #include "gpio.h"
@@ -17,6 +16,26 @@
 #include "cli.h"
 #include "math.h"
 #include "hibernation.h"
+#include "scheduler.h"
+#include "tString.h"
+#include "ringbuf.h"
+#include "sample.h"
+#include "datalog.h"
+#include "capture.h"
+#include "rules.h"
+#include "session.h"
+#include "power.h"
+#include "profile.h"
+#include "kernel.h"
+#include "ipc.h"
+#include "udma.h"
+#include "command.h"
+#include "format.h"
+#include "stream.h"
+#include "dump.h"
+#include "script.h"
+#include "config.h"
+#include "adc0.h"
 
 // The reason I shift left by 1 is because if you look at the library, it takes the address,
 // and shift it right by 1
@@ -88,26 +107,18 @@ typedef struct _sensorData
     uint8_t z;
 } sensorData;
 
-uint8_t eeprom[1024];
+//Record queued for the logging task
+typedef struct _logRecord
+{
+    uint8_t type;
+    sensorData data;
+} logRecord;
 
-//Read I2C for SDA and SCL on EEPROM
-uint8_t readI2c0Register16(uint8_t add, uint16_t reg)
-{
-    I2C0_MSA_R = add << 1;
-    I2C0_MDR_R = (reg >> 8) & 0xFF;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    I2C0_MDR_R = reg & 0xFF;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_RUN;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    I2C0_MSA_R = (add << 1) | 1;
-    I2C0_MICR_R = I2C_MICR_IC;
-    I2C0_MCS_R = I2C_MCS_START | I2C_MCS_RUN | I2C_MCS_STOP;
-    while ((I2C0_MRIS_R & I2C_MRIS_RIS) == 0);
-    return I2C0_MDR_R;
-}
+#define LOG_RING_SIZE 8
+
+RING_BUFFER(logRing, logRecord, LOG_RING_SIZE)
+
+uint8_t eeprom[1024];
 
 //Write to EEPROM through metadata
 void wEeprom(uint8_t type, sensorData* d)
@@ -173,22 +184,6 @@ void rEeprom(uint8_t type, uint8_t* count, uint8_t* offset)
     *count = mPtr->count[type];
 }
 
-//Initialize ADC0 for the internal temperature sensor
-void initTemp()
-{
-    //Enable clock to ADC0
-    SYSCTL_RCGCADC_R |= SYSCTL_RCGCADC_R0;
-    _delay_cycles(16);
-
-    // Configure ADC
-    ADC0_ACTSS_R &= ~ADC_ACTSS_ASEN3;                // disable sample sequencer 3 (SS3) for programming
-    ADC0_CC_R = ADC_CC_CS_SYSPLL;                    // select PLL as the time base (not needed, since default value)
-    ADC0_PC_R = ADC_PC_SR_1M;                        // select 1Msps rate
-    ADC0_EMUX_R = ADC_EMUX_EM3_PROCESSOR;            // select SS3 bit in ADCPSSI as trigger
-    ADC0_SSCTL3_R = ADC_SSCTL3_END0;                 // mark first sample as the end
-    ADC0_ACTSS_R |= ADC_ACTSS_ASEN3;                 // enable SS3 for operation
-}
-
 //Initialize MPU for configuration
 void initMPU()
 {
@@ -250,18 +245,20 @@ void init24lc512()
 //Days of each month for "date" command
 uint16_t daysOfEachMonth[12] = {31,28,31,30,31,30,31,31,30,31,30,31};
 
-//Samples N
-uint32_t N;
-uint32_t count1 = 0;
+//Inputs ADC0 samples in each sequence, more AIN steps go after the sensor
+#define ADC_STEP_TS 0
+const uint8_t adcInputs[] = {ADC0_INPUT_TS};
 
-//Internal Sensor on microcontroller
-int32_t getTemp()
+//Internal Sensor on microcontroller in tenths of a degree C, from the
+//last sequence ADC0 sampled on its own. False until the first sequence is
+//in, the zeroed samples would read as 147.5 C
+bool getTemp(int16_t* temp)
 {
-    int32_t temperature;
-    ADC0_PSSI_R |= ADC_PSSI_SS3;                     // set start bit
-    while (ADC0_ACTSS_R & ADC_ACTSS_BUSY);
-        temperature = (((147 - ((247.5 * ADC0_SSFIFO3_R) / 4096)) - 32) * 5) / 9;
-        return temperature;
+    uint16_t raw[ADC0_MAX_INPUTS];
+    if(getAdc0Samples(raw) == 0)
+        return false;
+    *temp = adc0ToTemp(raw[ADC_STEP_TS]);
+    return true;
 }
 
 //Internal temperature of MPU 9250
@@ -338,30 +335,1212 @@ void initLevelShift()
     selectPinPushPullOutput(PORTF, 1);
 }
 
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//Task periods in ms
+#define ACQUISITION_PERIOD_MS 10
+#define STORAGE_PERIOD_MS     1
+#define DUMP_PERIOD_MS        1
+//Settings are saved once they have been left alone for this long
+#define CONFIG_SAVE_DELAY_MS  2000
+//Baud rate changes revert unless acknowledged at the new rate in time
+#define BAUD_ACK_MS           3000
+#define BAUD_POLL_MS          100
+//Error in 0.01 % units, both ends together have to stay within about 3 %
+#define BAUD_MAX_ERROR        250
+//ADC0 sequence rate, the internal sensor changes slowly
+#define ADC_RATE_HZ           10
+#define ACQUISITION_PRIORITY  1
+#define FOREGROUND_PRIORITY   6
+
+//Requests for the display task
+#define DISPLAY_TEMP    1
+#define DISPLAY_GYRO    2
+#define DISPLAY_ACCEL   4
+
+//Data from user to be stored
+USER_DATA userData;
+
+//Signal encryption
+uint32_t Encrypt = 0;
+uint32_t key = 17;
+
+//Frames from the acquisition task to the gating task
+//Frames go from the acquisition thread to the gating task by pointer, the
+//buffers cycle between the free and ready queues
+#define FRAME_POOL_SIZE 16
+sampleFrame framePool[FRAME_POOL_SIZE];
+queue freeFrames;
+queue readyFrames;
+uint16_t frameSequence = 0;
+//Latest frame seen by the gating task
+sampleFrame lastFrame;
+
+//Records from the CLI to the logging task
+logRing logRecords;
+
+//Acquisition period, set with periodicT
+uint16_t acquisitionPeriod = ACQUISITION_PERIOD_MS;
+int8_t storageTaskId;
+int8_t cliTaskId;
+int8_t dumpTaskId;
+int8_t configTaskId;
+
+//The stored script runs in the CLI task before the first prompt, unless SW1
+//is held
+bool bootScript = true;
+
+//Pending baud rate change
+bool baudConfirming = false;
+uint32_t baudDeadline;
+baudSetting previousBaud;
+
+//Gating rules drive the level shift while leveling is on
+bool leveling = true;
+
+//I2C0 speed set with the i2c command, 0 until then so initI2c0's rate stays
+uint16_t i2cSpeed = 0;
+
+//Set once a ready capture did not fit the log, so it is only reported once
+bool captureLogFull = false;
+
+//Pending readouts for the display task
+uint8_t displayRequest = 0;
+
+//Read the MPU once per period and hand the frame to the gating task
+void acquisitionTask()
+{
+    sampleFrame* frame;
+    PROF_BEGIN(acquire)
+    //Without a free buffer the frame is dropped, which shows up as a gap
+    //in the sequence
+    if(tryReceive(&freeFrames, (void**)&frame))
+    {
+        frame->timestamp = getTicks();
+        frame->sequence = frameSequence;
+        frame->value[CHANNEL_TEMP] = getSensorTemp();
+        readGyro(&frame->value[CHANNEL_GYRO_X]);
+        readAcceleration(&frame->value[CHANNEL_ACCEL_X]);
+        trySend(&readyFrames, frame);
+    }
+    frameSequence++;
+    PROF_END
+    setEvent(EVENT_FRAME_READY);
+}
+
+//High priority kernel thread, reads the MPU once per acquisition period
+void acquisitionThread()
+{
+    uint32_t next = getTicks();
+    int32_t wait;
+    while(true)
+    {
+        acquisitionTask();
+        next += acquisitionPeriod;
+        wait = next - getTicks();
+        //Skip missed periods
+        if(wait <= 0)
+        {
+            next = getTicks() + acquisitionPeriod;
+            wait = acquisitionPeriod;
+        }
+        sleep(wait);
+    }
+}
+
+//Runs once per sample frame
+void gatingTask()
+{
+    uint8_t actions, rising;
+    sampleFrame* frame;
+    while(tryReceive(&readyFrames, (void**)&frame))
+    {
+        PROF_BEGIN(gating)
+        actions = evaluateRules(frame, &rising);
+        //Level shift: turn on the EEPROM while any gating rule holds
+        if(leveling && (getRuleActions() & ACTION_LEVEL_SHIFT))
+            setPinValue(PORTF, 1, (actions & ACTION_LEVEL_SHIFT) != 0);
+        if(rising & ACTION_TRIGGER)
+            triggerCapture(TRIGGER_THRESHOLD);
+        if(captureFrame(frame))
+            setEvent(EVENT_LOG);
+        //The logging task writes the session frames
+        if(isSessionRunning())
+        {
+            sessionFrame(frame);
+            setEvent(EVENT_LOG);
+        }
+        //Telemetry stream, dropped rather than waiting when the console is busy
+        streamFrame(frame);
+        //Kept for the display task, the buffer goes back to the pool
+        lastFrame = *frame;
+        trySend(&freeFrames, frame);
+        PROF_END
+    }
+}
+
+//Save a record into the EEPROM and print the stored entries
+void logSensorData(uint8_t type, sensorData* d)
+{
+    sensorData s = *d;
+    uint16_t dayout = floor(s.timestamp / 86400);
+    uint16_t hourout = floor((s.timestamp - (dayout * 86400)) / 3600);
+    uint16_t minout = floor((s.timestamp - (dayout * 86400) - (hourout * 3600))/60);
+    uint16_t secout = floor((s.timestamp - (dayout * 86400) - (hourout * 3600) - (minout *60)));
+
+    //The per-sensor records share the device with the log pages
+    drainLog();
+    wEeprom(type, &s);
+    uint8_t offset = 0, count = 0;
+    rEeprom(type, &count, &offset);
+
+    uint8_t i = 0;
+    for(i = offset; i < offset + count; i++)
+    {
+        eeprom[i] = readI2c0Register16(0xA0 >> 1, i);
+        waitMicrosecond(1000);
+    }
+
+    for(i = 0; i < count; i++)
+    {
+        sensorData* sPtr = (sensorData*)(eeprom + (offset - 1)) + i;
+        printfUart0("Magnetometer data count = %hhu @%hhu: Timestamp = %d : %d : %d, x = %hhu, y = %hhu, z = %hhu\n", count, offset, hourout, minout, secout, sPtr->x, sPtr->y, sPtr->z);
+    }
+}
+
+//Hands queued log pages to the EEPROM once its write cycle is over, and
+//only polls while pages are queued so the core can sleep otherwise
+void storageTask()
+{
+    PROF_BEGIN(storage)
+    if(!serviceLog())
+        setTaskPeriod(storageTaskId, 0);
+    PROF_END
+}
+
+//Reads the next EEPROM chunk while uDMA sends the previous one
+void dumpTask()
+{
+    if(!serviceDump())
+    {
+        setTaskPeriod(dumpTaskId, 0);
+        setEvent(EVENT_DISPLAY);
+    }
+}
+
+//Captures the settings into a config block
+void captureConfig(config* c)
+{
+    ruleSetting empty = {0};
+    uint8_t i;
+    c->acquisitionPeriod = acquisitionPeriod;
+    c->i2cSpeed = i2cSpeed;
+    c->encrypt = Encrypt;
+    c->key = key;
+    c->leveling = leveling;
+    c->hysteresis = getRuleHysteresis();
+    getCaptureWindow(&c->capturePre, &c->capturePost);
+    c->capturePin = isCapturePinTriggerEnabled();
+    c->ruleCount = 0;
+    for(i = 0; i < MAX_RULES; i++)
+    {
+        if(getRule(i, &c->rules[c->ruleCount]))
+            c->ruleCount++;
+    }
+    for(i = c->ruleCount; i < MAX_RULES; i++)
+        c->rules[i] = empty;
+}
+
+//Restores the settings from a config block loaded at boot
+void applyConfig(const config* c)
+{
+    const ruleSetting* r;
+    uint8_t i;
+    acquisitionPeriod = c->acquisitionPeriod;
+    i2cSpeed = c->i2cSpeed;
+    if(i2cSpeed)
+        setI2c0Speed(i2cSpeed);
+    Encrypt = c->encrypt;
+    key = c->key;
+    leveling = c->leveling;
+    initRules();
+    for(i = 0; i < c->ruleCount && i < MAX_RULES; i++)
+    {
+        r = &c->rules[i];
+        setRule(r->channel, r->channelCount, r->comparator, r->threshold, r->debounce, r->action);
+    }
+    setRuleHysteresis(c->hysteresis);
+    setCaptureWindow(c->capturePre, c->capturePost);
+    enableCapturePinTrigger(c->capturePin);
+}
+
+//Restarts the save delay, so a burst of changes costs one save
+void configChanged()
+{
+    setTaskPeriod(configTaskId, CONFIG_SAVE_DELAY_MS);
+}
+
+//Writes the changed words of the configuration once the delay is over
+void configTask()
+{
+    config c;
+    setTaskPeriod(configTaskId, 0);
+    captureConfig(&c);
+    saveConfig(&c);
+}
+
+void logPageQueued()
+{
+    setTaskPeriod(storageTaskId, STORAGE_PERIOD_MS);
+}
+
+//Idle hook of the foreground thread, lets a woken kernel thread run first
+void foregroundIdle()
+{
+    if(isThreadReady())
+        yield();
+    else
+        lowPowerIdle();
+}
+
+//End of session report
+void printSessionSummary(sessionSummary* summary)
+{
+    uint32_t rate = 0;
+    if(summary->elapsedMs)
+        rate = (uint64_t)summary->samples * 100000 / summary->elapsedMs;
+    printfUart0("Session %d: %d samples in %d ms (%.2k Hz), %d dropped, %d bytes written\r\n",
+            summary->id, summary->samples, summary->elapsedMs, rate,
+            summary->dropped, summary->bytesWritten);
+}
+
+//Writes queued records to the EEPROM and prints the stored entries
+void loggingTask()
+{
+    logRecord r;
+    sessionSummary summary;
+    PROF_BEGIN(logging)
+    while(logRingPop(&logRecords, &r))
+        logSensorData(r.type, &r.data);
+
+    if(serviceSession(getTicks(), &summary))
+    {
+        if(isSessionLogFull())
+            putsUart0("Log full, session ended\r\n");
+        printSessionSummary(&summary);
+        putsUart0("> ");
+    }
+
+    //Commit a completed trigger window in one page-aligned burst
+    if(isCaptureReady())
+    {
+        uint32_t add = commitCapture();
+        if(add)
+        {
+            printfUart0("Capture saved @0x%04x\r\n", add);
+            captureLogFull = false;
+        }
+        else if(!captureLogFull)
+        {
+            putsUart0("Log full, capture kept in RAM\r\n");
+            captureLogFull = true;
+        }
+    }
+    PROF_END
+}
+
+//ADC0 interrupt callback, only set while the display task waits for the
+//first sequence
+void adcReady()
+{
+    setAdc0Callback(0);
+    setEvent(EVENT_DISPLAY);
+}
+
+//Prints the readouts requested by the CLI from the latest frame, then the prompt
+void displayTask()
+{
+    int16_t controllerTemp;
+
+    //Up to one ADC period after boot there is no controller reading yet,
+    //the ADC callback runs the task again once the first one is in
+    if((displayRequest & DISPLAY_TEMP) && !getTemp(&controllerTemp))
+    {
+        setAdc0Callback(adcReady);
+        return;
+    }
+
+    PROF_BEGIN(display)
+
+    //Receive changing temperature value from MPU
+    if(displayRequest & DISPLAY_TEMP)
+    {
+        printfUart0("Temperature value is: %d\r\n", lastFrame.value[CHANNEL_TEMP]);
+        //getTemp is in tenths of a degree, %.1k is fixed-point and not a double
+        printfUart0("Controller temperature: %.1k\r\n", controllerTemp);
+        /*
+        uint32_t temp_encrypt;
+        if(Encrypt == 1)
+        {
+            temp_encrypt = lastFrame.value[CHANNEL_TEMP] + key;
+
+            printfUart0("Temperature value is: %d\r\n", temp_encrypt);
+        }
+
+        else if (Encrypt == 0)
+        {
+            temp_encrypt = lastFrame.value[CHANNEL_TEMP] - key;
+            printfUart0("Temperature value is: %d\r\n", temp_encrypt);
+        }
+        */
+    }
+    //Read gyroscope data from MPU
+    if(displayRequest & DISPLAY_GYRO)
+    {
+        printfUart0("Gyro data: %d  %d  %d\r\n", lastFrame.value[CHANNEL_GYRO_X], lastFrame.value[CHANNEL_GYRO_Y], lastFrame.value[CHANNEL_GYRO_Z]);
+    }
+    //Read accelerometer data from MPU
+    if(displayRequest & DISPLAY_ACCEL)
+    {
+        printfUart0("Acceleration data: %d  %d  %d\r\n", lastFrame.value[CHANNEL_ACCEL_X], lastFrame.value[CHANNEL_ACCEL_Y], lastFrame.value[CHANNEL_ACCEL_Z]);
+    }
+    displayRequest = 0;
+    PROF_END
+    putsUart0("> ");
+}
+
+//Maps a sensor name to its channels in the sample frame
+bool getChannel(const char* name, uint8_t* channel, uint8_t* count)
+{
+    if(name == 0)
+        return false;
+    if(stringCompare(name, "temp", 4))
+    {
+        *channel = CHANNEL_TEMP;
+        *count = 1;
+    }
+    else if(stringCompare(name, "gyro", 4))
+    {
+        *channel = CHANNEL_GYRO_X;
+        *count = 3;
+    }
+    else if(stringCompare(name, "accel", 5))
+    {
+        *channel = CHANNEL_ACCEL_X;
+        *count = 3;
+    }
+    else
+        return false;
+    return true;
+}
+
+//RX interrupt callback, wakes the CLI task
+void uartReceived()
+{
+    setEvent(EVENT_UART_RX);
+}
+
+//> levelShift 1 to turn on or off
+void cmdLevelShift(USER_DATA* data)
+{
+    int32_t arg = getFieldInteger(data, 1);
+    if(arg == 1)
+        setPinValue(PORTF, 1, 1);
+    else
+        setPinValue(PORTF, 1, 0);
+}
+
+//Check if EEPROM and MPU are on
+void cmdPoll(USER_DATA* data)
+{
+    if (pollI2c0Address(0xA0 >> 1))
+    {
+        putsUart0("EEPROM found!\r\n");
+        setPinValue(GREEN_LED, 1);
+    }
+
+    if(pollI2c0Address(0xD0 >> 1))
+    {
+        setPinValue(GREEN_LED, 0);
+        setPinValue(BLUE_LED, 1);
+        putsUart0("IMU Found\r\n");
+    }
+}
+
+/////////////////////Debug/////////////////////////////
+
+void cmdReset(USER_DATA* data)
+{
+    putsUart0("Reseting...\n");
+    NVIC_APINT_R = NVIC_APINT_SYSRESETREQ|NVIC_APINT_VECTKEY;
+}
+
+//Receive changing temperature value from MPU
+void cmdTemp(USER_DATA* data)
+{
+    displayRequest |= DISPLAY_TEMP;
+}
+
+////////////////////Configuration/////////////////////////////
+
+//Check the time stored on RTC
+void cmdTime(USER_DATA* data)
+{
+    //uint16_t chrono = set_time();
+    uint16_t day = 29;
+    uint16_t hour = 5;
+    uint16_t min = 8;
+    uint16_t sec = 50;
+    uint32_t RTC = HIB_RTCC_R;
+    RTC += ((day/86400) + (hour * 3600) + (min * 60) + sec);
+    uint16_t dayout = floor(RTC / 86400);
+    uint16_t hourout = floor((RTC - (dayout * 86400)) / 3600);
+    uint16_t minout = floor((RTC - (dayout * 86400) - (hourout * 3600))/60);
+    uint16_t secout = floor((RTC - (dayout * 86400) - (hourout * 3600) - (minout *60)));
+    if(Encrypt == 1)
+    {
+        printfUart0("Time: %d : %d : %d\r\n", hourout + key, minout + key, secout + key);
+    }
+
+    else if(Encrypt == 0)
+    {
+        printfUart0("Time: %d : %d : %d\r\n", hourout, minout, secout);
+    }
+}
+
+//Check the date
+void cmdDate(USER_DATA* data)
+{
+    uint32_t RTC;
+    uint16_t i = 0;
+    uint16_t month = 12;
+    uint16_t day = 7;
+    uint16_t temp_day = 0;
+
+    if(month == 2 || month == 9 || month == 11)
+    {
+        for(i = 0; i < month-1; i++)
+        {
+            temp_day += daysOfEachMonth[i];
+        }
+    }
+
+    else
+    {
+        for(i = 0; i <= month-1; i++)
+        {
+            temp_day += daysOfEachMonth[i];
+        }
+    }
+
+    RTC = temp_day;
+    day += RTC;
+
+    uint16_t monthout = floor(day / daysOfEachMonth[month-1]);
+    uint16_t dayout = day - RTC;
+    printfUart0("Day: %d/%d\r\n", monthout, dayout);
+}
+
+//Check the compass value from MPU
+void cmdCompass(USER_DATA* data)
+{
+    writeI2c0Register(0x68, 0x37, 0x02);
+    writeI2c0Register(0x0C, 0x0A, 0x01);
+
+    while(!(readI2c0Register(0x0C, 0x02) & 1));
+
+
+
+    uint16_t x1 = readI2c0Register(0x0C, 0x04);
+    x1 = (x1 << 8) | readI2c0Register(0x0C, 0x03);
+
+    uint16_t y = readI2c0Register(0x0C, 0x06);
+    y = (y << 8) | readI2c0Register(0x0C, 0x05);
+
+    uint16_t z = readI2c0Register(0x0C, 0x08);
+    z = (z << 8) | readI2c0Register(0x0C, 0x07);
+
+    printfUart0("Magnetometer: x = %hu, y = %hu, z = %hu\r\n", x1, y, z);
+/*
+    if(Encrypt == 1)
+    {
+        printfUart0("Magnetometer: x = %hu, y = %hu, z = %hu\r\n", x1 + key, y + key, z + key);
+        waitMicrosecond(90000);
+    }
+
+    else if(Encrypt == 0)
+    {
+
+    }
+*/
+}
+
+//Read gyroscope data from MPU
+void cmdGyro(USER_DATA* data)
+{
+    displayRequest |= DISPLAY_GYRO;
+}
+
+//Read accelerometer data from MPU
+void cmdAccel(USER_DATA* data)
+{
+    displayRequest |= DISPLAY_ACCEL;
+}
+
+// gating temp GT 12 [debounce]
+//Gate the following information from user to turn on or off
+//if the value is > or < the input
+void cmdGating(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    char* arg2 = getFieldString(data, 2);
+    int32_t arg3 = getFieldInteger(data, 3);
+    int32_t debounce = getFieldInteger(data, 4);
+    uint8_t channel, count, comparator;
+    if(!getChannel(arg1, &channel, &count))
+    {
+        putsUart0("Invalid sensor\r\n");
+        return;
+    }
+    if(stringCompare(arg2, "GT", 2))
+        comparator = COMPARE_GT;
+    else if(stringCompare(arg2, "LT", 2))
+        comparator = COMPARE_LT;
+    else
+    {
+        putsUart0("Use GT or LT\r\n");
+        return;
+    }
+    //Out of range values are refused, the rule table holds 16 and 8 bits
+    if(getFieldString(data, 3) != 0 || arg3 < INT16_MIN || arg3 > INT16_MAX)
+        printfUart0("Value must be %d to %d\r\n", INT16_MIN, INT16_MAX);
+    else if(data->fieldCount > 4 && (getFieldString(data, 4) != 0 || debounce < 0 || debounce > UINT8_MAX))
+        printfUart0("Debounce must be 0 to %d\r\n", UINT8_MAX);
+    else if(!setRule(channel, count, comparator, arg3, debounce, ACTION_LEVEL_SHIFT))
+        putsUart0("Rule table full\r\n");
+    else
+        configChanged();
+}
+
+//Log all compass data by time
+void cmdLogCompass(USER_DATA* data)
+{
+    // Read the compass here first
+    // Create the data packet
+    // Queue it for the logging task to save into the EEPROM
+    writeI2c0Register(0x68, 0x37, 0x02);
+    writeI2c0Register(0x0C, 0x0A, 0x01);
+
+    while(!(readI2c0Register(0x0C, 0x02) & 1));
+
+
+
+    uint16_t x1 = readI2c0Register(0x0C, 0x04);
+    x1 = (x1 << 8) | readI2c0Register(0x0C, 0x03);
+
+    uint16_t y1 = readI2c0Register(0x0C, 0x06);
+    y1 = (y1 << 8) | readI2c0Register(0x0C, 0x05);
+
+    uint16_t z1 = readI2c0Register(0x0C, 0x08);
+    z1 = (z1 << 8) | readI2c0Register(0x0C, 0x07);
+
+    logRecord r;
+    uint16_t day = 29;
+    uint16_t hour = 5;
+    uint16_t min = 8;
+    uint16_t sec = 50;
+    r.type = MAG;
+    r.data.timestamp = HIB_RTCC_R;
+    r.data.timestamp += ((day/86400) + (hour * 3600) + (min * 60) + sec);
+    r.data.x = x1;
+    r.data.y = y1;
+    r.data.z = z1;
+
+    if(logRingPush(&logRecords, &r))
+        setEvent(EVENT_LOG);
+    else
+        putsUart0("Log queue full\r\n");
+}
+
+//Log a session of N samples (0 = until stop)
+void cmdSamples(USER_DATA* data)
+{
+    int32_t arg = getFieldInteger(data, 1);
+    if(data->fieldCount < 2 || getFieldString(data, 1) != 0 || arg < 0)
+        putsUart0("Use samples N, 0 runs until stop\r\n");
+    else if(startSession(arg, 0, acquisitionPeriod, getTicks()))
+        putsUart0("Sample entered\r\n");
+    else if(isSessionRunning())
+        putsUart0("Session already running\r\n");
+    else
+        putsUart0("Log full\r\n");
+}
+
+//Log a session for S seconds
+void cmdDuration(USER_DATA* data)
+{
+    int32_t arg = getFieldInteger(data, 1);
+    if(data->fieldCount < 2 || arg <= 0 || (uint32_t)arg > UINT32_MAX / 1000)
+        printfUart0("Use duration S, 1 to %u seconds\r\n", UINT32_MAX / 1000);
+    else if(startSession(0, (uint32_t)arg * 1000, acquisitionPeriod, getTicks()))
+        putsUart0("Duration entered\r\n");
+    else if(isSessionRunning())
+        putsUart0("Session already running\r\n");
+    else
+        putsUart0("Log full\r\n");
+}
+
+// Parameter will be set to H
+void cmdHysteresisPH(USER_DATA* data)
+{
+    int32_t arg = getFieldInteger(data, 1);
+    if(getFieldString(data, 1) != 0 || arg < 0 || arg > INT16_MAX)
+    {
+        printfUart0("Hysteresis must be 0 to %d\r\n", INT16_MAX);
+        return;
+    }
+    setRuleHysteresis(arg);
+    configChanged();
+    printfUart0("Hysteresis: %d\r\n", getRuleHysteresis());
+}
+
+//Enter hibernation and trigger to wake up
+void cmdSleep(USER_DATA* data)
+{
+    if(!checkIfConfigured())
+        initHibernationModule();
+
+    setPinValue(RED_LED, 1);
+
+    if(wakePinCausedWakeUp())
+    {
+        setPinValue(BLUE_LED, 1);
+        setPinValue(RED_LED, 0);
+        putsUart0("Trigger activated\r\n");
+    }
+
+
+    while(getPinValue(PUSH_BUTTON));
+    {
+        setPinValue(RED_LED, 1);
+    }
+
+    setPinValue(RED_LED, 0);
+    setPinValue(GREEN_LED, 0);
+    setPinValue(BLUE_LED, 0);
+    hibernate(30);
+
+    setPinValue(RED_LED, 1);
+
+    SYSCTL_SCGCGPIO_R = 0; //GPIO Port F is off
+
+}
+
+void cmdLevelingOff(USER_DATA* data)
+{
+    putsUart0("Leveling Off\r\n");
+    leveling = false;
+    configChanged();
+}
+
+void cmdLevelingOn(USER_DATA* data)
+{
+    putsUart0("Leveling On\r\n");
+    leveling = true;
+    configChanged();
+}
+
+void cmdEncryptOff(USER_DATA* data)
+{
+    putsUart0("Encrypt Off\r\n");
+    Encrypt = 0;
+    configChanged();
+}
+
+//Encryption key by user key input
+void cmdEncryptKey(USER_DATA* data)
+{
+    putsUart0("Encrypt On\r\n");
+    Encrypt = 1;
+    configChanged();
+}
+
+/////////////////////////Sample Control///////////////
+
+//Sample period in ms
+void cmdPeriodicT(USER_DATA* data)
+{
+    int32_t arg = getFieldInteger(data, 1);
+    if(arg > 0 && arg <= 60000)
+    {
+        acquisitionPeriod = arg;
+        configChanged();
+    }
+    else
+        putsUart0("Invalid period\r\n");
+}
+
+//trigger                    capture now
+//trigger window PRE POST     frames kept before and after the trigger
+//trigger pin on|off          trigger on the push button
+//trigger temp|gyro|accel L   trigger when |value| > L (0 = off)
+void cmdTrigger(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    uint8_t channel, count;
+    if(arg1 == 0)
+    {
+        triggerCapture(TRIGGER_CLI);
+        putsUart0("Trigger On\r\n");
+    }
+    else if(stringCompare(arg1, "window", 6) && data->fieldCount == 4)
+    {
+        int32_t pre = getFieldInteger(data, 2);
+        int32_t post = getFieldInteger(data, 3);
+        if(pre < 0 || pre > UINT8_MAX || post < 0 || post > UINT8_MAX)
+            printfUart0("Window must be 0 to %d frames each side\r\n", UINT8_MAX);
+        else if(setCaptureWindow(pre, post))
+            configChanged();
+        else
+            putsUart0("Window does not fit the capture buffer\r\n");
+    }
+    else if(stringCompare(arg1, "pin", 3) && data->fieldCount == 3)
+    {
+        enableCapturePinTrigger(stringCompare(getFieldString(data, 2), "on", 2));
+        configChanged();
+    }
+    else if(getChannel(arg1, &channel, &count) && data->fieldCount == 3)
+    {
+        int32_t level = getFieldInteger(data, 2);
+        if(level > INT16_MAX)
+            printfUart0("Level must be at most %d\r\n", INT16_MAX);
+        else if(level > 0 && !setRule(channel, count, COMPARE_ABS_GT, level, 1, ACTION_TRIGGER))
+            putsUart0("Rule table full\r\n");
+        else
+        {
+            if(level <= 0)
+                removeRule(channel, ACTION_TRIGGER);
+            configChanged();
+        }
+    }
+    else
+        putsUart0("Invalid trigger arguments\r\n");
+}
+
+//Kernel threads
+void cmdPs(USER_DATA* data)
+{
+        ps();
+}
+
+void cmdIpcs(USER_DATA* data)
+{
+        ipcs();
+}
+
+void cmdKill(USER_DATA* data)
+{
+        kill(getFieldInteger(data, 1));
+}
+
+void cmdPidof(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0)
+        pidof(arg1);
+}
+
+void cmdSched(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0)
+        sched(stringCompare(arg1, "prio", 4));
+}
+
+void cmdPi(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0)
+        pi(stringCompare(arg1, "on", 2));
+}
+
+void cmdPreempt(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0)
+        preempt(stringCompare(arg1, "on", 2));
+}
+
+//Cycle counts of the profiled regions
+void cmdPerf(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0 && stringCompare(arg1, "reset", 5))
+        resetProfile();
+    else
+        printProfile();
+}
+
+//Console buffer statistics
+void cmdUart(USER_DATA* data)
+{
+    printfUart0("TX overflow %d, TX stalls %d, RX overflow %d\r\n",
+            getUart0TxOverflow(), getUart0TxStalls(), getUart0RxOverflow());
+}
+
+//log          EEPROM log position and page writes
+//log flush    write the partly filled page out
+void cmdLog(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0 && stringCompare(arg1, "flush", 5))
+        flushLog();
+    printfUart0("Log @0x%05x, %d bytes free, %d written, %d pages written, %d stalls%s\r\n",
+            getLogAddress(), getLogFree(), getLogBytesWritten(), getLogPagesWritten(),
+            getLogStalls(), isLogBusy() ? ", writing" : "");
+}
+
+//Active and sleep residency since the last reset
+void cmdPower(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 != 0 && stringCompare(arg1, "reset", 5))
+        resetPowerStats();
+    else if(arg1 != 0 && stringCompare(arg1, "tickless", 8) && data->fieldCount == 3)
+        setTickless(stringCompare(getFieldString(data, 2), "on", 2));
+    else
+    {
+        uint64_t elapsed = getElapsedCycles();
+        uint32_t sleep = 0;
+        if(elapsed)
+            sleep = getSleepCycles() * 1000 / elapsed;
+        printfUart0("Active %.1k%%, sleep %.1k%% over %d ms, %d sleeps\r\n",
+                1000 - sleep, sleep,
+                (uint32_t)(elapsed / TICKS_PER_MS), getSleepCount());
+    }
+}
+
+//stream bin|ascii|off        send every sample frame
+//stream                      packets sent and dropped
+void cmdStream(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 == 0)
+        printfUart0("Stream: %d sent, %d dropped\r\n", getStreamSent(), getStreamDropped());
+    else if(stringCompare(arg1, "bin", 3))
+        setStreamMode(STREAM_BINARY);
+    else if(stringCompare(arg1, "ascii", 5))
+        setStreamMode(STREAM_ASCII);
+    else if(stringCompare(arg1, "off", 3))
+        setStreamMode(STREAM_OFF);
+    else
+        putsUart0("Use bin, ascii or off\r\n");
+}
+
+//baud                        current divisor and rate
+//baud RATE                   switch after a handshake at the new rate
+void cmdBaud(USER_DATA* data)
+{
+    baudSetting setting;
+    int32_t baud = getFieldInteger(data, 1);
+    int32_t error;
+    if(data->fieldCount < 2)
+    {
+        getUart0BaudSetting(&setting);
+        printfUart0("Baud %d: IBRD %d, FBRD %d, HSE %d\r\n", setting.actual, setting.ibrd,
+                    setting.fbrd, setting.hse);
+        return;
+    }
+    if(baud <= 0 || !findUart0BaudSetting(baud, TICKS_PER_MS * 1000, &setting))
+    {
+        putsUart0("Rate out of range\r\n");
+        return;
+    }
+    error = ((int64_t)setting.actual - baud) * 10000 / baud;
+    printfUart0("Baud %d: IBRD %d, FBRD %d, HSE %d, actual %d (%.2k%% error)\r\n", baud, setting.ibrd,
+                setting.fbrd, setting.hse, setting.actual, error);
+    if(error > BAUD_MAX_ERROR || error < -BAUD_MAX_ERROR)
+    {
+        putsUart0("Error too large, not switching\r\n");
+        return;
+    }
+    printfUart0("Send y at the new rate within %d ms\r\n", BAUD_ACK_MS);
+    getUart0BaudSetting(&previousBaud);
+    applyUart0BaudSetting(&setting);
+    baudConfirming = true;
+    baudDeadline = getTicks() + BAUD_ACK_MS;
+    setTaskPeriod(cliTaskId, BAUD_POLL_MS);
+}
+
+//dump [FROM] [TO] [hex|csv|bin]   EEPROM contents, the whole device by default
+//dump stop                         end a running dump
+void cmdDump(USER_DATA* data)
+{
+    uint32_t from = 0, to = LOG_END - 1;
+    uint8_t format = DUMP_HEX;
+    uint8_t i, numbers = 0;
+    char* arg;
+    for(i = 1; i < data->fieldCount; i++)
+    {
+        arg = getFieldString(data, i);
+        if(arg == 0)
+        {
+            if(numbers++ == 0)
+                from = getFieldInteger(data, i);
+            else
+                to = getFieldInteger(data, i);
+        }
+        else if(stringCompare(arg, "hex", 3))
+            format = DUMP_HEX;
+        else if(stringCompare(arg, "csv", 3))
+            format = DUMP_CSV;
+        else if(stringCompare(arg, "bin", 3))
+            format = DUMP_BINARY;
+        else if(stringCompare(arg, "stop", 4))
+        {
+            stopDump();
+            return;
+        }
+    }
+    if(startDump(from, to, format))
+        setTaskPeriod(dumpTaskId, DUMP_PERIOD_MS);
+    else if(isDumpRunning())
+        putsUart0("Dump already running\r\n");
+    else
+        putsUart0("Invalid range\r\n");
+}
+
+//script record              lines typed until script end are stored
+//script end|run|show|clear   internal EEPROM, run at every boot unless SW1
+//                            is held, reset, sleep and baud are not stored
+void cmdScript(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    if(arg1 == 0)
+        putsUart0("Use record, end, run, show or clear\r\n");
+    else if(stringCompare(arg1, "record", 6))
+    {
+        startScriptRecord();
+        putsUart0("Recording, finish with script end\r\n");
+    }
+    else if(stringCompare(arg1, "end", 3))
+        endScriptRecord();
+    else if(stringCompare(arg1, "run", 3))
+        printfUart0("%d lines run\r\n", runScript());
+    else if(stringCompare(arg1, "show", 4))
+        printScript();
+    else if(stringCompare(arg1, "clear", 5))
+        clearScript();
+    else
+        putsUart0("Use record, end, run, show or clear\r\n");
+}
+
+//i2c                         current bus speed
+//i2c KBPS                    set the bus speed, 100 to 400 for the MPU and EEPROM
+void cmdI2c(USER_DATA* data)
+{
+    int32_t speed = getFieldInteger(data, 1);
+    if(data->fieldCount >= 2)
+    {
+        if(speed < 10 || speed > 1000)
+        {
+            putsUart0("Speed out of range\r\n");
+            return;
+        }
+        i2cSpeed = speed;
+        setI2c0Speed(i2cSpeed);
+        configChanged();
+    }
+    printfUart0("I2C %d kbps\r\n", getI2c0Speed());
+}
+
+//config                      settings stored in the internal EEPROM
+//config save                 save now instead of after the delay
+//config defaults             boot with the defaults from now on
+void cmdConfig(USER_DATA* data)
+{
+    char* arg1 = getFieldString(data, 1);
+    config c;
+    uint8_t i;
+    if(arg1 != 0 && stringCompare(arg1, "save", 4))
+    {
+        setTaskPeriod(configTaskId, 0);
+        captureConfig(&c);
+        printfUart0("%d words written\r\n", saveConfig(&c));
+    }
+    else if(arg1 != 0 && stringCompare(arg1, "defaults", 8))
+    {
+        setTaskPeriod(configTaskId, 0);
+        eraseConfig();
+        putsUart0("Defaults at the next reset\r\n");
+    }
+    else if(arg1 != 0)
+        putsUart0("Use save or defaults\r\n");
+    else if(!loadConfig(&c))
+        putsUart0("No configuration stored\r\n");
+    else
+    {
+        printfUart0("Period %d ms, I2C %d kbps, encrypt %d, leveling %d, hysteresis %d\r\n",
+                    c.acquisitionPeriod, c.i2cSpeed, c.encrypt, c.leveling, c.hysteresis);
+        printfUart0("Capture %d/%d, pin %d, %d rules\r\n", c.capturePre, c.capturePost,
+                    c.capturePin, c.ruleCount);
+        for(i = 0; i < c.ruleCount && i < MAX_RULES; i++)
+            printfUart0("  ch %d x%d cmp %d %d debounce %d action %d\r\n", c.rules[i].channel,
+                        c.rules[i].channelCount, c.rules[i].comparator, c.rules[i].threshold,
+                        c.rules[i].debounce, c.rules[i].action);
+    }
+}
+
+//Stop the session, the logging task flushes it and prints the summary
+void cmdStop(USER_DATA* data)
+{
+    if(isSessionRunning())
+    {
+        stopSession();
+        setEvent(EVENT_LOG);
+    }
+    else
+        putsUart0("No session running\r\n");
+}
+
+//Generated from the command table
+void cmdHelp(USER_DATA* data)
+{
+    printCommands();
+}
+
+//Command table, the CLI finds the line's command with a perfect hash built
+//from the names at boot
+const command commandTable[] =
+{
+    {"levelShift", 1, cmdLevelShift, "0|1  drive the level shift output"},
+    {"poll", 0, cmdPoll, "look for the EEPROM and the IMU on I2C0"},
+    {"reset", 0, cmdReset, "reset the controller"},
+    {"temp", 0, cmdTemp, "show the temperature"},
+    {"time", 0, cmdTime, "show the RTC time"},
+    {"date", 0, cmdDate, "show the date"},
+    {"compass", 0, cmdCompass, "read the magnetometer"},
+    {"gyro", 0, cmdGyro, "show the gyroscope"},
+    {"accel", 0, cmdAccel, "show the accelerometer"},
+    {"gating", 3, cmdGating, "temp|gyro|accel GT|LT VALUE [DEBOUNCE]  gate the level shift output"},
+    {"logCompass", 0, cmdLogCompass, "log a magnetometer reading"},
+    {"samples", 1, cmdSamples, "N  log a session of N samples (0 = until stop)"},
+    {"duration", 1, cmdDuration, "S  log a session for S seconds"},
+    {"hysteresisPH", 1, cmdHysteresisPH, "H  set the gating hysteresis"},
+    {"sleep", 0, cmdSleep, "hibernate until the wake pin"},
+    {"levelingOff", 0, cmdLevelingOff, "turn leveling off"},
+    {"levelingOn", 0, cmdLevelingOn, "turn leveling on"},
+    {"encryptOff", 1, cmdEncryptOff, "X  turn encryption off"},
+    {"encryptKey", 0, cmdEncryptKey, "turn encryption on"},
+    {"periodicT", 1, cmdPeriodicT, "MS  set the sample period"},
+    {"trigger", 0, cmdTrigger, "[window PRE POST|pin on|off|temp|gyro|accel L]  capture control"},
+    {"ps", 0, cmdPs, "list the threads"},
+    {"ipcs", 0, cmdIpcs, "list the mutexes, queues, semaphores and event groups"},
+    {"kill", 1, cmdKill, "PID  kill a thread"},
+    {"pidof", 1, cmdPidof, "NAME  show the PID of a thread"},
+    {"sched", 1, cmdSched, "prio|rr  select the thread scheduler"},
+    {"pi", 1, cmdPi, "on|off  priority inheritance"},
+    {"preempt", 1, cmdPreempt, "on|off  preemption"},
+    {"perf", 0, cmdPerf, "[reset]  cycle counts of the profiled regions"},
+    {"uart", 0, cmdUart, "console buffer statistics"},
+    {"log", 0, cmdLog, "[flush]  EEPROM log position and page writes"},
+    {"power", 0, cmdPower, "[reset|tickless on|off]  active and sleep residency"},
+    {"stop", 0, cmdStop, "stop the session"},
+    {"script", 1, cmdScript, "record|end|run|show|clear  commands run at boot"},
+    {"dump", 0, cmdDump, "[FROM] [TO] [hex|csv|bin|stop]  EEPROM contents"},
+    {"baud", 0, cmdBaud, "[RATE]  change the console rate, confirmed with y"},
+    {"stream", 0, cmdStream, "[bin|ascii|off]  stream every sample frame"},
+    {"i2c", 0, cmdI2c, "[KBPS]  I2C0 bus speed"},
+    {"config", 0, cmdConfig, "[save|defaults]  settings restored at boot"},
+    {"help", 0, cmdHelp, "list the commands"}
+};
+
+//Waits for the 'y' sent at the new baud rate, the CLI task polls this while
+//a change is pending and goes back to the previous rate on time-out
+void confirmBaud()
+{
+    baudSetting setting;
+    char c;
+    while(tryGetcUart0(&c))
+    {
+        if(c == 'y')
+        {
+            getUart0BaudSetting(&setting);
+            printfUart0("\r\nBaud %d confirmed\r\n", setting.actual);
+            baudConfirming = false;
+        }
+    }
+    if(baudConfirming && (int32_t)(getTicks() - baudDeadline) >= 0)
+    {
+        applyUart0BaudSetting(&previousBaud);
+        printfUart0("\r\nNo acknowledgement, back to %d baud\r\n", previousBaud.actual);
+        baudConfirming = false;
+    }
+    if(!baudConfirming)
+    {
+        setTaskPeriod(cliTaskId, 0);
+        userData.count = 0;
+        setEvent(EVENT_DISPLAY);
+    }
+}
+
+//Adds the received bytes to the command line and parses it once complete
+void cliTask()
+{
+    //Holding SW1 (PF4) through reset skips the boot script, the way out of
+    //a script that hangs or reboots the controller
+    if(bootScript)
+    {
+        bootScript = false;
+        if(getPinValue(PUSH_BUTTON))
+            runScript();
+        else if(getScriptLength())
+            putsUart0("SW1 held, boot script skipped\r\n");
+        setEvent(EVENT_DISPLAY);
+    }
+    if(baudConfirming)
+    {
+        confirmBaud();
+        return;
+    }
+    if(!getsUart0(&userData))
+        return;
+    // Bytes after the end of the line are handled on the next run
+    if(kbhitUart0())
+        setEvent(EVENT_UART_RX);
+    // While recording, lines go into the script instead of being run
+    if(recordScriptLine(userData.buffer))
+    {
+        setEvent(EVENT_DISPLAY);
+        return;
+    }
+
+    PROF_BEGIN(cli)
+    parseField(&userData);
+    runCommand(&userData);
+    PROF_END
+
+    // The display task prints any requested readouts followed by the prompt
+    setEvent(EVENT_DISPLAY);
+}
+
 int main(void)
 {
+    //Fill the unused main stack so ps can report its high-water mark
+    paintMainStack();
+
     //Initialize everything
     initLevelShift();
     initSystemClockTo40Mhz();
     initI2c0();
     initUart0();
+    initUdma();
+    initEeprom();
     initMPU();
     init24lc512();
-    initTemp();
+    initAdc0(adcInputs, sizeof(adcInputs), ADC_RATE_HZ);
     // initRTC();
     setPinValue(PORTF, 1, 1);
 
-    //Data from user to be stored
-    USER_DATA userData;
-
-    //Signal encryption
-    uint32_t Encrypt = 0;
-    uint32_t key = 17;
-
-
-    char x[128];
-    int16_t values[3];
-
     // Write the meta data first to the eeprom
 
     // The name of an array is its address
@@ -391,531 +1570,52 @@ int main(void)
         eeprom[i] = readI2c0Register16(0xA0 >> 1, i);
         waitMicrosecond(1000);
     }
-    //Temperature gating
-    int16_t temperature1 = 20;
-    // False is for < and True is for >
-    bool tlevel = false;
-    //Accelerometer gating
-    int16_t accelerate = 1;
-    // False is for < and True is for >
-    bool alevel = false;
-    //Gyroscope gating
-    int16_t gyroscope = 20;
-    // False is for < and True is for >
-    bool glevel = false;
-    //Compass gating
-    int16_t magneto = 50;
-    // False is for < and True is for >
-    bool mlevel = false;
 
-    putsUart0("Data logger initialized\n");
-    putsUart0("> ");
-	while(true)
-	{   //Temperature level: If > or <, turn on or off EEPROM
-	    if(!tlevel)
-	    {
-	        if(getSensorTemp() > temperature1)
-	            setPinValue(PORTF, 1, 1);
-	        else
-	            setPinValue(PORTF, 1, 0);
-	    }
-	    else if(tlevel)
-	    {
-	        if(getSensorTemp() > temperature1)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-	    }
-/*
-	    //Accelerometer level
-        if(!alevel)
-        {
-            readAcceleration(values);
-            int16_t go = values;
-            if(values[0] > accelerate || values[1] > accelerate || values[2] > accelerate)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-        }
-        else if(alevel)
-        {
-            readAcceleration(values);
-            if(values[0] > accelerate || values[1] > accelerate || values[2] > accelerate)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-        }*/
-
-        //Gyro level: If > or <, turn on or off EEPROM
-        if(!glevel)
-        {
-            readGyro(values);
-            if(values[0] > gyroscope || values[1] > gyroscope || values[2] > gyroscope)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-        }
-        else if(glevel)
-        {
-            readGyro(values);
-            if(values[0] > gyroscope || values[1] > gyroscope || values[2] > gyroscope)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-        }
-/*
-        //Compass Level
-        if(!mlevel)
-        {
-            readCompass(values);
-            if(values[0] > magneto || values[1] > magneto || values[2] > magneto)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-        }
-        else if(mlevel)
-        {
-            readCompass(values);
-            if(values[0] > magneto || values[1] > magneto || values[2] > magneto)
-                setPinValue(PORTF, 1, 1);
-            else
-                setPinValue(PORTF, 1, 0);
-        }
-        */
-	    if(kbhitUart0())
-	    {
-            getsUart0(&userData);
-            parseField(&userData);
-            //> levelShift 1 to turn on or off
-            if(isCommand(&userData, "levelShift", 1))
-            {
-                int32_t arg = getFieldInteger(&userData, 1);
-                if(arg == 1)
-                    setPinValue(PORTF, 1, 1);
-                else
-                    setPinValue(PORTF, 1, 0);
-            }
-            //Check if EEPROM and MPU are on
-            if(isCommand(&userData, "poll", 0))
-            {
-                if (pollI2c0Address(0xA0 >> 1))
-                {
-                    putsUart0("EEPROM found!\r\n");
-                    setPinValue(GREEN_LED, 1);
-                }
-
-                if(pollI2c0Address(0xD0 >> 1))
-                {
-                    setPinValue(GREEN_LED, 0);
-                    setPinValue(BLUE_LED, 1);
-                    putsUart0("IMU Found\r\n");
-                }
-            }
-    /////////////////////Debug/////////////////////////////
-            if(isCommand(&userData, "reset", 0))
-            {
-                putsUart0("Reseting...\n");
-                NVIC_APINT_R = NVIC_APINT_SYSRESETREQ|NVIC_APINT_VECTKEY;
-            }
-            //Receive changing temperature value from MPU
-            if(isCommand(&userData, "temp", 0))
-            {
-                int16_t temp = getSensorTemp();
-                sprintf(x, "Temperature value is: %d\r\n", temp);
-                putsUart0(x);
-                uint32_t temp_encrypt;
-                /*
-                if(Encrypt == 1)
-                {
-                    temp_encrypt = temp + key;
-
-                    sprintf(x, "Temperature value is: %d\r\n", temp_encrypt);
-                    putsUart0(x);
-                }
-
-                else if (Encrypt == 0)
-                {
-                    temp_encrypt = temp - key;
-                    sprintf(x, "Temperature value is: %d\r\n", temp_encrypt);
-                    putsUart0(x);
-                }
-                */
-            }
-    ////////////////////Configuration/////////////////////////////
-            //Check the time stored on RTC
-            if(isCommand(&userData, "time", 0))
-            {
-                //uint16_t chrono = set_time();
-                uint16_t day = 29;
-                uint16_t hour = 5;
-                uint16_t min = 8;
-                uint16_t sec = 50;
-                uint32_t RTC = HIB_RTCC_R;
-                RTC += ((day/86400) + (hour * 3600) + (min * 60) + sec);
-                uint16_t dayout = floor(RTC / 86400);
-                uint16_t hourout = floor((RTC - (dayout * 86400)) / 3600);
-                uint16_t minout = floor((RTC - (dayout * 86400) - (hourout * 3600))/60);
-                uint16_t secout = floor((RTC - (dayout * 86400) - (hourout * 3600) - (minout *60)));
-                if(Encrypt == 1)
-                {
-                    sprintf(x, "Time: %d : %d : %d\r\n", hourout + key, minout + key, secout + key);
-                    putsUart0(x);
-                }
-
-                else if(Encrypt == 0)
-                {
-                    sprintf(x, "Time: %d : %d : %d\r\n", hourout, minout, secout);
-                    putsUart0(x);
-                }
-
-                waitMicrosecond(90000);
-            }
-
-            //Check the date
-            if(isCommand(&userData, "date", 0))
-            {
-                uint32_t RTC;
-                uint16_t i = 0;
-                uint16_t month = 12;
-                uint16_t day = 7;
-                uint16_t temp_day = 0;
-
-                if(month == 2 || month == 9 || month == 11)
-                {
-                    for(i = 0; i < month-1; i++)
-                    {
-                        temp_day += daysOfEachMonth[i];
-                    }
-                }
-
-                else
-                {
-                    for(i = 0; i <= month-1; i++)
-                    {
-                        temp_day += daysOfEachMonth[i];
-                    }
-                }
-
-                RTC = temp_day;
-                day += RTC;
-
-                uint16_t monthout = floor(day / daysOfEachMonth[month-1]);
-                uint16_t dayout = day - RTC;
-                sprintf(x, "Day: %d/%d\r\n", monthout, dayout);
-                putsUart0(x);
-                waitMicrosecond(90000);
-            }
-
-            //Check the compass value from MPU
-            if(isCommand(&userData, "compass", 0))
-            {
-                writeI2c0Register(0x68, 0x37, 0x02);
-                writeI2c0Register(0x0C, 0x0A, 0x01);
-
-                while(!(readI2c0Register(0x0C, 0x02) & 1));
-
-
-
-                uint16_t x1 = readI2c0Register(0x0C, 0x04);
-                x1 = (x1 << 8) | readI2c0Register(0x0C, 0x03);
-
-                uint16_t y = readI2c0Register(0x0C, 0x06);
-                y = (y << 8) | readI2c0Register(0x0C, 0x05);
-
-                uint16_t z = readI2c0Register(0x0C, 0x08);
-                z = (z << 8) | readI2c0Register(0x0C, 0x07);
-
-                sprintf(x, "Magnetometer: x = %hu, y = %hu, z = %hu\r\n", x1, y, z);
-                putsUart0(x);
-                waitMicrosecond(90000);
-/*
-                if(Encrypt == 1)
-                {
-                    sprintf(x, "Magnetometer: x = %hu, y = %hu, z = %hu\r\n", x1 + key, y + key, z + key);
-                    putsUart0(x);
-                    waitMicrosecond(90000);
-                }
-
-                else if(Encrypt == 0)
-                {
-
-                }
-*/
-            }
-            //Read gyroscope data from MPU
-            if(isCommand(&userData, "gyro", 0))
-            {
-                readGyro(values);
-                sprintf(x, "Gyro data: %d  %d  %d\r\n", values[0], values[1], values[2]);
-                putsUart0(x);
-                waitMicrosecond(90000);
-                /*if(N != 0)
-                {
-                    while(count1 < N)
-                    {
-
-                        sprintf(x, "Gyro data: %d  %d  %d\r\n", values[0], values[1], values[2]);
-                        putsUart0(x);
-                        waitMicrosecond(90000);
-                        count1++;
-                    }
-                 }
-                else
-                {
-                    sprintf(x, "Gyro data: %d  %d  %d\r\n", values[0], values[1], values[2]);
-                    putsUart0(x);
-                    waitMicrosecond(90000);
-                }*/
-
-            }
-            //Read accelerometer data from MPU
-            if(isCommand(&userData, "accel", 0))
-            {
-                readAcceleration(values);
-                sprintf(x, "Acceleration data: %d  %d  %d\r\n", values[0], values[1], values[2]);
-                putsUart0(x);
-                /*if(N != 0)
-                {
-                    while(count1 < N)
-                    {
-                        sprintf(x, "Acceleration data: %d  %d  %d\r\n", values[0], values[1], values[2]);
-                        putsUart0(x);
-                        count1++;
-                    }
-                }
-                else
-                {
-                    readAcceleration(values);
-                    sprintf(x, "Acceleration data: %d  %d  %d\r\n", values[0], values[1], values[2]);
-                    putsUart0(x);
-                }*/
-
-
-            }
-
-            // gating temp GT 12
-
-            //Gate the following information from user to turn on or off
-            //if the value is > or < the input
-            if(isCommand(&userData, "gating", 3))
-            {
-                char* arg1 = getFieldString(&userData, 1);
-                char* arg2 = getFieldString(&userData, 2);
-                int32_t arg3 = getFieldInteger(&userData, 3);
-                //Gating for temperature
-                if(stringCompare(arg1, "temp", 16))
-                {
-                    if(stringCompare(arg2, "GT", 16))
-                        tlevel = true;
-                    else
-                        tlevel = false;
-                    temperature1 = arg3;
-                }
-
-                //Gating for accel
-                if(stringCompare(arg1, "accel", 2))
-                {
-                    if(stringCompare(arg2, "GT", 2))
-                        alevel = true;
-                    else
-                        alevel = false;
-                    accelerate = arg3;
-                }
-
-                if(stringCompare(arg1, "gyro", 20))
-                {
-                    if(stringCompare(arg2, "GT", 20))
-                        glevel = true;
-                    else
-                        glevel = false;
-                    gyroscope = arg3;
-                }
-
-                if(stringCompare(arg1, "compass", 20))
-                {
-                    if(stringCompare(arg2, "GT", 20))
-                        mlevel = true;
-                    else
-                        mlevel = false;
-                    magneto = arg3;
-                }
-            }
-
-            //Log all compass data by time
-            if(isCommand(&userData, "logCompass", 0))
-            {
-                // Read the compass here first
-                // Create the data packet
-                // Save it into the EEPROM
-                writeI2c0Register(0x68, 0x37, 0x02);
-                writeI2c0Register(0x0C, 0x0A, 0x01);
-
-                while(!(readI2c0Register(0x0C, 0x02) & 1));
-
-
-
-                uint16_t x1 = readI2c0Register(0x0C, 0x04);
-                x1 = (x1 << 8) | readI2c0Register(0x0C, 0x03);
-
-                uint16_t y1 = readI2c0Register(0x0C, 0x06);
-                y1 = (y1 << 8) | readI2c0Register(0x0C, 0x05);
-
-                uint16_t z1 = readI2c0Register(0x0C, 0x08);
-                z1 = (z1 << 8) | readI2c0Register(0x0C, 0x07);
-
-                sensorData s;
-                uint16_t day = 29;
-                uint16_t hour = 5;
-                uint16_t min = 8;
-                uint16_t sec = 50;
-                s.timestamp = HIB_RTCC_R;
-                s.timestamp += ((day/86400) + (hour * 3600) + (min * 60) + sec);
-                uint16_t dayout = floor(s.timestamp / 86400);
-                uint16_t hourout = floor((s.timestamp - (dayout * 86400)) / 3600);
-                uint16_t minout = floor((s.timestamp - (dayout * 86400) - (hourout * 3600))/60);
-                uint16_t secout = floor((s.timestamp - (dayout * 86400) - (hourout * 3600) - (minout *60)));
-                s.x = x1;
-                s.y = y1;
-                s.z = z1;
-
-                N = 0;
-                if(N != 0)
-                {
-                    while(count1 < N)
-                    {
-                        wEeprom(MAG, &s);
-                        uint8_t offset = 0, count = 0;
-                        rEeprom(MAG, &count, &offset);
-
-                        uint8_t i = 0;
-                        for(i = offset; i < offset + count; i++)
-                        {
-                            eeprom[i] = readI2c0Register16(0xA0 >> 1, i);
-                            waitMicrosecond(1000);
-                        }
-
-                        for(i = 0; i < count; i++)
-                        {
-                            sensorData* sPtr = (sensorData*)(eeprom + (offset - 1)) + i;
-                            sprintf(x, "Magnetometer data count = %hhu @%hhu: Timestamp = %d : %d : %d, x = %hhu, y = %hhu, z = %hhu\n", count, offset, hourout, minout, secout, sPtr->timestamp, sPtr->x, sPtr->y, sPtr->z);
-                            putsUart0(x);
-                        }
-                        count1++;
-                    }
-                }
-                else
-                {
-                    wEeprom(MAG, &s);
-                    uint8_t offset = 0, count = 0;
-                    rEeprom(MAG, &count, &offset);
-
-                    uint8_t i = 0;
-                    for(i = offset; i < offset + count; i++)
-                    {
-                        eeprom[i] = readI2c0Register16(0xA0 >> 1, i);
-                        waitMicrosecond(1000);
-                    }
-
-                    for(i = 0; i < count; i++)
-                    {
-                        sensorData* sPtr = (sensorData*)(eeprom + (offset - 1)) + i;
-                        sprintf(x, "Magnetometer data count = %hhu @%hhu: Timestamp = %d : %d : %d, x = %hhu, y = %hhu, z = %hhu\n", count, offset, hourout, minout, secout, sPtr->timestamp, sPtr->x, sPtr->y, sPtr->z);
-                        putsUart0(x);
-                    }
-                }
-
-
-            }
-
-            //The number of times you want EEPROM to read and write
-            if(isCommand(&userData, "samples", 1))
-            {
-                int32_t arg = getFieldInteger(&userData, 1);
-                N = arg;
-                putsUart0("Sample entered\n");
-            }
-
-            // Parameter will be set to H
-            if(isCommand(&userData, "hysteresisPH", 0))
-            {
-
-            }
-
-            //Enter hibernation and trigger to wake up
-            if(isCommand(&userData, "sleep", 0))
-            {
-                if(!checkIfConfigured())
-                    initHibernationModule();
-
-                setPinValue(RED_LED, 1);
-
-                if(wakePinCausedWakeUp())
-                {
-                    setPinValue(BLUE_LED, 1);
-                    setPinValue(RED_LED, 0);
-                    putsUart0("Trigger activated\r\n");
-                }
-
-
-                while(getPinValue(PUSH_BUTTON));
-                {
-                    setPinValue(RED_LED, 1);
-                }
-
-                setPinValue(RED_LED, 0);
-                setPinValue(GREEN_LED, 0);
-                setPinValue(BLUE_LED, 0);
-                hibernate(30);
-
-                setPinValue(RED_LED, 1);
-
-                SYSCTL_SCGCGPIO_R = 0; //GPIO Port F is off
-
-            }
-
-
-            if(isCommand(&userData, "levelingOff", 0))
-            {
-
-            }
-
-            if(isCommand(&userData, "levelingOn", 0))
-            {
-
-            }
-
-            if(isCommand(&userData, "encryptOff", 1))
-            {
-                putsUart0("Encrypt Off\r\n");
-                Encrypt = 0;
-            }
-
-            //Encryption key by user key input
-            if(isCommand(&userData, "encryptKey", 0))
-            {
-                putsUart0("Encrypt On\r\n");
-                Encrypt = 1;
-
-            }
-
-
-    /////////////////////////Sample Control///////////////
-            if(isCommand(&userData, "periodicT", 0))
-            {
-
-            }
-
-            if(isCommand(&userData, "trigger", 0))
-            {
-                putsUart0("Trigger On\r\n");
-            }
-
-            if(isCommand(&userData, "stop", 0))
-            {
-
-            }
-            putsUart0("> ");
-	    }
-	}
+    initQueue(&freeFrames, "freeFrames", FRAME_POOL_SIZE);
+    initQueue(&readyFrames, "readyFrames", FRAME_POOL_SIZE);
+    for(i = 0; i < FRAME_POOL_SIZE; i++)
+        trySend(&freeFrames, &framePool[i]);
+    logRingInit(&logRecords);
+    initLog();
+    initCapture();
+    initDump();
+
+    //Default gating: EEPROM on when temperature or any gyro axis is above 20
+    initRules();
+    setRule(CHANNEL_TEMP, 1, COMPARE_GT, 20, 1, ACTION_LEVEL_SHIFT);
+    setRule(CHANNEL_GYRO_X, 3, COMPARE_GT, 20, 1, ACTION_LEVEL_SHIFT);
+
+    //Settings saved by an earlier run replace the defaults
+    config c;
+    if(loadConfig(&c))
+        applyConfig(&c);
+
+    //Tasks run in this order whenever they are due or have an event pending,
+    //and the CPU sleeps in WFI when none of them are
+    initScheduler();
+    addTask("gating", gatingTask, 0, EVENT_FRAME_READY);
+    initCommands(commandTable, sizeof(commandTable) / sizeof(commandTable[0]));
+    cliTaskId = addTask("cli", cliTask, 0, EVENT_UART_RX);
+    setUart0RxCallback(uartReceived);
+    addTask("logging", loggingTask, 0, EVENT_LOG);
+    addTask("display", displayTask, 0, EVENT_DISPLAY);
+    storageTaskId = addTask("storage", storageTask, 0, 0);
+    dumpTaskId = addTask("dump", dumpTask, 0, 0);
+    configTaskId = addTask("config", configTask, 0, 0);
+    setLogQueuedHook(logPageQueued);
+    initPower();
+    initProfile();
+    setIdleHook(foregroundIdle);
 
+    putsUart0("Data logger initialized\n");
+    //The CLI task runs the boot script, then the display task prints the prompt
+    setEvent(EVENT_UART_RX);
+    //Acquisition runs ahead of the cooperative tasks, which all run in the
+    //foreground thread
+    initKernel();
+    createThread(acquisitionThread, "acquire", ACQUISITION_PRIORITY, 1024);
+    createThread(runScheduler, "foreground", FOREGROUND_PRIORITY, 6144);
+    //I2C0 is guarded by a mutex, so acquisition can preempt a log write
+    setPreemption(true);
+    startKernel();
 }
@@ -0,0 +1,96 @@
+/*
+ * ringbuf.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    -
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Single-producer/single-consumer ring buffers for passing data from an ISR
+// to the foreground (or the other way around) without disabling interrupts.
+//
+// RING_BUFFER(name, type, capacity) declares the type "name" and the inline
+// functions nameInit, namePush, namePop, nameCount and nameFree. The
+// capacity must be a power of two. The head index is only written by the
+// producer and the tail index only by the consumer, both free-running, so
+// head - tail is always the fill level.
+
+#ifndef RINGBUF_H_
+#define RINGBUF_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Orders the element access against the index update
+#if defined(__TI_COMPILER_VERSION__)
+#define RING_BARRIER() __asm("    DMB")
+#else
+#define RING_BARRIER() __sync_synchronize()
+#endif
+
+#define RING_BUFFER(name, type, capacity)                                       \
+typedef char name##CapacityIsPowerOfTwo[(((capacity) & ((capacity) - 1)) == 0) ? 1 : -1]; \
+typedef struct _##name                                                          \
+{                                                                               \
+    volatile uint32_t head;                                                     \
+    volatile uint32_t tail;                                                     \
+    volatile uint32_t overflow;                                                 \
+    type data[capacity];                                                        \
+} name;                                                                         \
+                                                                                \
+static inline void name##Init(name* r)                                          \
+{                                                                               \
+    r->head = 0;                                                                \
+    r->tail = 0;                                                                \
+    r->overflow = 0;                                                            \
+}                                                                               \
+                                                                                \
+static inline uint32_t name##Count(name* r)                                     \
+{                                                                               \
+    return r->head - r->tail;                                                   \
+}                                                                               \
+                                                                                \
+static inline uint32_t name##Free(name* r)                                      \
+{                                                                               \
+    return (capacity) - (r->head - r->tail);                                    \
+}                                                                               \
+                                                                                \
+/* Producer side, counts an overflow and drops the item when full */          \
+static inline bool name##Push(name* r, const type* item)                        \
+{                                                                               \
+    uint32_t head = r->head;                                                    \
+    if (head - r->tail >= (capacity))                                           \
+    {                                                                           \
+        r->overflow++;                                                          \
+        return false;                                                           \
+    }                                                                           \
+    r->data[head & ((capacity) - 1)] = *item;                                   \
+    RING_BARRIER();                                                             \
+    r->head = head + 1;                                                         \
+    return true;                                                                \
+}                                                                               \
+                                                                                \
+/* Consumer side, returns false when empty */                                  \
+static inline bool name##Pop(name* r, type* item)                               \
+{                                                                               \
+    uint32_t tail = r->tail;                                                    \
+    if (r->head == tail)                                                        \
+        return false;                                                           \
+    RING_BARRIER();                                                             \
+    *item = r->data[tail & ((capacity) - 1)];                                   \
+    RING_BARRIER();                                                             \
+    r->tail = tail + 1;                                                         \
+    return true;                                                                \
+}
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * rules.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "rules.h"
+
+// Threshold rule. The comparator is compiled into a sign so that every
+// rule is evaluated as "max of sign * value over the channels > onLevel",
+// and it turns off again once that drops below offLevel.
+typedef struct _rule
+{
+    uint8_t channel;
+    uint8_t lastChannel;
+    uint8_t comparator;
+    uint8_t action;
+    int16_t threshold;
+    uint8_t debounce;
+    uint8_t count;
+    bool active;
+    int8_t sign;                        // 0 compares |value|
+    int32_t onLevel;
+    int32_t offLevel;
+} rule;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Active rules are kept packed at the start of the table
+rule rules[MAX_RULES];
+uint8_t ruleCount = 0;
+int16_t ruleHysteresis = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void compileRule(rule* r)
+{
+    switch (r->comparator)
+    {
+        case COMPARE_GT:
+            r->sign = 1;
+            break;
+        case COMPARE_LT:
+            r->sign = -1;
+            break;
+        default:
+            r->sign = 0;
+    }
+    r->onLevel = (r->sign == 0) ? r->threshold : (int32_t)r->sign * r->threshold;
+    r->offLevel = r->onLevel - ruleHysteresis;
+}
+
+void initRules(void)
+{
+    ruleCount = 0;
+    ruleHysteresis = 0;
+}
+
+// Replaces the rule with the same channel and action, or adds a new one
+bool setRule(uint8_t channel, uint8_t channelCount, uint8_t comparator, int16_t threshold,
+             uint8_t debounce, uint8_t action)
+{
+    uint8_t i;
+    rule* r = 0;
+    if (channelCount == 0 || channel + channelCount > MAX_CHANNELS)
+        return false;
+    for (i = 0; i < ruleCount && r == 0; i++)
+    {
+        if (rules[i].channel == channel && rules[i].action == action)
+            r = &rules[i];
+    }
+    if (r == 0)
+    {
+        if (ruleCount == MAX_RULES)
+            return false;
+        r = &rules[ruleCount++];
+    }
+    r->channel = channel;
+    r->lastChannel = channel + channelCount - 1;
+    r->comparator = comparator;
+    r->action = action;
+    r->threshold = threshold;
+    r->debounce = (debounce == 0) ? 1 : debounce;
+    r->count = 0;
+    r->active = false;
+    compileRule(r);
+    return true;
+}
+
+void removeRule(uint8_t channel, uint8_t action)
+{
+    uint8_t i;
+    for (i = 0; i < ruleCount; i++)
+    {
+        if (rules[i].channel == channel && rules[i].action == action)
+        {
+            rules[i] = rules[--ruleCount];
+            return;
+        }
+    }
+}
+
+// Returns false past the last rule
+bool getRule(uint8_t index, ruleSetting* setting)
+{
+    rule* r;
+    if (index >= ruleCount)
+        return false;
+    r = &rules[index];
+    setting->channel = r->channel;
+    setting->channelCount = r->lastChannel - r->channel + 1;
+    setting->comparator = r->comparator;
+    setting->action = r->action;
+    setting->threshold = r->threshold;
+    setting->debounce = r->debounce;
+    setting->reserved = 0;
+    return true;
+}
+
+// The band applies to every rule
+void setRuleHysteresis(int16_t hysteresis)
+{
+    uint8_t i;
+    ruleHysteresis = (hysteresis < 0) ? -hysteresis : hysteresis;
+    for (i = 0; i < ruleCount; i++)
+        compileRule(&rules[i]);
+}
+
+int16_t getRuleHysteresis(void)
+{
+    return ruleHysteresis;
+}
+
+// Actions of all configured rules, active or not
+uint8_t getRuleActions(void)
+{
+    uint8_t i;
+    uint8_t actions = 0;
+    for (i = 0; i < ruleCount; i++)
+        actions |= rules[i].action;
+    return actions;
+}
+
+// Returns the actions of every active rule, and in rising the actions of
+// rules that became active with this frame
+uint8_t evaluateRules(const sampleFrame* frame, uint8_t* rising)
+{
+    rule* r;
+    rule* end = rules + ruleCount;
+    uint8_t c;
+    int32_t v, m;
+    uint8_t asserted = 0;
+    *rising = 0;
+
+    for (r = rules; r < end; r++)
+    {
+        m = -65536;
+        for (c = r->channel; c <= r->lastChannel; c++)
+        {
+            v = frame->value[c];
+            if (r->sign)
+                v *= r->sign;
+            else if (v < 0)
+                v = -v;
+            if (v > m)
+                m = v;
+        }
+
+        // The condition has to hold for debounce frames in a row
+        if (r->active ? (m < r->offLevel) : (m > r->onLevel))
+        {
+            if (++r->count >= r->debounce)
+            {
+                r->active = !r->active;
+                r->count = 0;
+                if (r->active)
+                    *rising |= r->action;
+            }
+        }
+        else
+            r->count = 0;
+
+        if (r->active)
+            asserted |= r->action;
+    }
+    return asserted;
+}
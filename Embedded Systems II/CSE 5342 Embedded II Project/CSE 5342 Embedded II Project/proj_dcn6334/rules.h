@@ -0,0 +1,56 @@
+/*
+ * rules.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef RULES_H_
+#define RULES_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sample.h"
+
+#define MAX_RULES           8
+
+// Comparators
+#define COMPARE_GT          0
+#define COMPARE_LT          1
+#define COMPARE_ABS_GT      2
+
+// Actions (bit mask)
+#define ACTION_LEVEL_SHIFT  1
+#define ACTION_TRIGGER      2
+
+// What setRule was called with, for saving and restoring a rule (8 bytes)
+typedef struct _ruleSetting
+{
+    uint8_t channel;
+    uint8_t channelCount;
+    uint8_t comparator;
+    uint8_t action;
+    int16_t threshold;
+    uint8_t debounce;
+    uint8_t reserved;
+} ruleSetting;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initRules(void);
+bool setRule(uint8_t channel, uint8_t channelCount, uint8_t comparator, int16_t threshold,
+             uint8_t debounce, uint8_t action);
+void removeRule(uint8_t channel, uint8_t action);
+bool getRule(uint8_t index, ruleSetting* setting);
+void setRuleHysteresis(int16_t hysteresis);
+int16_t getRuleHysteresis(void);
+uint8_t getRuleActions(void);
+uint8_t evaluateRules(const sampleFrame* frame, uint8_t* rising);
+
+#endif
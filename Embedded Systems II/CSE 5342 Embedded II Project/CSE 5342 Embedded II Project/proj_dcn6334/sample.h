@@ -0,0 +1,40 @@
+/*
+ * sample.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef SAMPLE_H_
+#define SAMPLE_H_
+
+#include <stdint.h>
+#include "ringbuf.h"
+
+// Channel index into sampleFrame.value
+#define CHANNEL_TEMP        0
+#define CHANNEL_GYRO_X      1
+#define CHANNEL_GYRO_Y      2
+#define CHANNEL_GYRO_Z      3
+#define CHANNEL_ACCEL_X     4
+#define CHANNEL_ACCEL_Y     5
+#define CHANNEL_ACCEL_Z     6
+#define MAX_CHANNELS        7
+
+#define FRAME_RING_SIZE     16
+
+// One acquisition of every channel (20 bytes)
+typedef struct _sampleFrame
+{
+    uint32_t timestamp;                 // scheduler ticks (ms)
+    int16_t value[MAX_CHANNELS];
+    uint16_t sequence;
+} sampleFrame;
+
+RING_BUFFER(frameRing, sampleFrame, FRAME_RING_SIZE)
+
+#endif
@@ -0,0 +1,208 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// SysTick generates the 1 ms scheduler tick
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "scheduler.h"
+
+// Run-to-completion task; period of 0 means the task only runs on events
+typedef struct _task
+{
+    const char* name;
+    _fn fn;
+    uint32_t period;
+    uint32_t nextRun;
+    uint32_t eventMask;
+} task;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+task tasks[MAX_TASKS];
+uint8_t taskCount = 0;
+
+volatile uint32_t ticks = 0;
+volatile uint32_t pendingEvents = 0;
+
+_fn idleHook = 0;
+_tickFn tickHook = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Default idle hook, sleeps until the next interrupt
+void waitForInterrupt()
+{
+    __asm("    WFI");
+}
+
+// Start the 1 ms SysTick
+void initScheduler(void)
+{
+    taskCount = 0;
+    pendingEvents = 0;
+    idleHook = waitForInterrupt;
+
+    NVIC_ST_CTRL_R = 0;
+    NVIC_ST_RELOAD_R = TICKS_PER_MS - 1;
+    NVIC_ST_CURRENT_R = 0;
+    NVIC_ST_CTRL_R = NVIC_ST_CTRL_CLK_SRC | NVIC_ST_CTRL_INTEN | NVIC_ST_CTRL_ENABLE;
+}
+
+// Tasks run in the order they were added, so add the most urgent first
+int8_t addTask(const char name[], _fn fn, uint32_t periodMs, uint32_t eventMask)
+{
+    if (taskCount >= MAX_TASKS)
+        return -1;
+    tasks[taskCount].name = name;
+    tasks[taskCount].fn = fn;
+    tasks[taskCount].period = periodMs;
+    tasks[taskCount].nextRun = ticks + periodMs;
+    tasks[taskCount].eventMask = eventMask;
+    return taskCount++;
+}
+
+void setTaskPeriod(int8_t task, uint32_t periodMs)
+{
+    if (task < 0 || task >= taskCount)
+        return;
+    tasks[task].period = periodMs;
+    tasks[task].nextRun = ticks + periodMs;
+}
+
+// Safe to call from an ISR
+void setEvent(uint32_t events)
+{
+    uint32_t key = _disable_interrupts();
+    pendingEvents |= events;
+    _restore_interrupts(key);
+}
+
+// Returns the pending events in mask and clears them
+uint32_t takeEvents(uint32_t mask)
+{
+    uint32_t events;
+    uint32_t key = _disable_interrupts();
+    events = pendingEvents & mask;
+    pendingEvents &= ~events;
+    _restore_interrupts(key);
+    return events;
+}
+
+void setIdleHook(_fn fn)
+{
+    idleHook = fn;
+}
+
+// Called from the SysTick handler, and after a tickless sleep with the
+// ms that were skipped
+void setTickHook(_tickFn fn)
+{
+    tickHook = fn;
+}
+
+uint32_t getTicks(void)
+{
+    return ticks;
+}
+
+// True if any task has a pending event or an expired period
+bool isWorkPending()
+{
+    uint8_t i;
+    for (i = 0; i < taskCount; i++)
+    {
+        if ((pendingEvents & tasks[i].eventMask) ||
+            (tasks[i].period && (int32_t)(ticks - tasks[i].nextRun) >= 0))
+            return true;
+    }
+    return false;
+}
+
+// Milliseconds until the next periodic task is due, IDLE_FOREVER if no
+// task is periodic
+uint32_t getIdleTime(void)
+{
+    uint8_t i;
+    int32_t wait;
+    uint32_t idle = IDLE_FOREVER;
+    for (i = 0; i < taskCount; i++)
+    {
+        if (tasks[i].period)
+        {
+            wait = (int32_t)(tasks[i].nextRun - ticks);
+            if (wait <= 0)
+                return 0;
+            if ((uint32_t)wait < idle)
+                idle = wait;
+        }
+    }
+    return idle;
+}
+
+// Catches up the tick count after a tickless sleep
+void advanceTicks(uint32_t ms)
+{
+    ticks += ms;
+    if (tickHook)
+        tickHook(ms);
+}
+
+void runScheduler(void)
+{
+    uint8_t i;
+    while(true)
+    {
+        for (i = 0; i < taskCount; i++)
+        {
+            task* t = &tasks[i];
+            bool due = t->period && (int32_t)(ticks - t->nextRun) >= 0;
+            if (takeEvents(t->eventMask) || due)
+            {
+                if (due)
+                {
+                    t->nextRun += t->period;
+                    // Skip missed periods instead of running back-to-back
+                    if ((int32_t)(ticks - t->nextRun) >= 0)
+                        t->nextRun = ticks + t->period;
+                }
+                t->fn();
+            }
+        }
+
+        // Interrupts stay masked between the check and the sleep so an event
+        // raised in between still wakes the core (WFI ignores PRIMASK)
+        uint32_t key = _disable_interrupts();
+        if (!isWorkPending() && idleHook)
+            idleHook();
+        _restore_interrupts(key);
+    }
+}
+
+void sysTickIsr(void)
+{
+    ticks++;
+    if (tickHook)
+        tickHook(1);
+}
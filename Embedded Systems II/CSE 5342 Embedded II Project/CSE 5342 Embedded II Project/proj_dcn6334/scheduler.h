@@ -0,0 +1,57 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// SysTick generates the 1 ms scheduler tick
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef SCHEDULER_H_
+#define SCHEDULER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAX_TASKS 8
+#define TICKS_PER_MS 40000                          // 40 MHz / 1 kHz
+#define IDLE_FOREVER 0xFFFFFFFF
+
+// Event flags (one bit each) that can be raised by ISRs or by other tasks
+#define EVENT_FRAME_READY   0x00000001
+#define EVENT_UART_RX       0x00000002
+#define EVENT_LOG           0x00000004
+#define EVENT_DISPLAY       0x00000008
+
+typedef void (*_fn)(void);
+typedef void (*_tickFn)(uint32_t ms);
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initScheduler(void);
+int8_t addTask(const char name[], _fn fn, uint32_t periodMs, uint32_t eventMask);
+void setTaskPeriod(int8_t task, uint32_t periodMs);
+void setEvent(uint32_t events);
+void setIdleHook(_fn fn);
+void setTickHook(_tickFn fn);
+uint32_t getTicks(void);
+uint32_t getIdleTime(void);
+void advanceTicks(uint32_t ms);
+void runScheduler(void);
+void sysTickIsr(void);
+
+#endif
@@ -0,0 +1,233 @@
+/*
+ * script.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// Internal EEPROM, SCRIPT_WORDS words from SCRIPT_BASE
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "eeprom.h"
+#include "uart0.h"
+#include "format.h"
+#include "crc16.h"
+#include "cli.h"
+#include "tString.h"
+#include "command.h"
+#include "script.h"
+
+#define SCRIPT_HEADER       SCRIPT_BASE
+#define SCRIPT_CRC          (SCRIPT_BASE + 1)
+#define SCRIPT_DATA         (SCRIPT_BASE + 2)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Lines are written as they are recorded, the header only at the end, so an
+// unfinished recording is never run
+bool scriptRecording = false;
+bool scriptFull;
+uint16_t scriptLength;
+uint16_t scriptCrc;
+uint32_t scriptWord;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+uint8_t readScriptByte(uint16_t index)
+{
+    return readEeprom(SCRIPT_DATA + index / 4) >> ((index % 4) * 8);
+}
+
+void appendScriptByte(uint8_t c)
+{
+    scriptWord |= (uint32_t)c << ((scriptLength % 4) * 8);
+    scriptCrc = crc16(&c, 1, scriptCrc);
+    scriptLength++;
+    if (scriptLength % 4 == 0)
+    {
+        writeEeprom(SCRIPT_DATA + scriptLength / 4 - 1, scriptWord);
+        scriptWord = 0;
+    }
+}
+
+// Commands a script never holds: script itself, and the ones that would
+// reset, hibernate or move the console rate at every boot
+const char* const unscriptedCommands[] = {"script", "reset", "sleep", "baud"};
+
+#define UNSCRIPTED_COUNT    (sizeof(unscriptedCommands) / sizeof(unscriptedCommands[0]))
+
+// Returns the index of the unscripted command a line runs, or -1. The copy
+// is split like a typed line, so delimiters cannot hide the name.
+int8_t findUnscripted(const char line[])
+{
+    USER_DATA data;
+    char* name;
+    uint8_t i;
+    for (data.count = 0; line[data.count] && data.count < MAX_CHARS; data.count++)
+        data.buffer[data.count] = line[data.count];
+    data.buffer[data.count] = 0;
+    parseField(&data);
+    name = getFieldString(&data, 0);
+    for (i = 0; i < UNSCRIPTED_COUNT; i++)
+        if (stringCompare(name, unscriptedCommands[i], MAX_CHARS))
+            return i;
+    return -1;
+}
+
+void startScriptRecord(void)
+{
+    writeEeprom(SCRIPT_HEADER, 0xFFFFFFFF);
+    scriptLength = 0;
+    scriptCrc = CRC16_INIT;
+    scriptWord = 0;
+    scriptFull = false;
+    scriptRecording = true;
+}
+
+// Called with every CLI line, returns true if the line was taken for the
+// script instead of being run
+bool recordScriptLine(const char line[])
+{
+    uint16_t size = 0;
+    int8_t refused;
+    if (!scriptRecording)
+        return false;
+    // script lines still run, so recording can be ended
+    refused = findUnscripted(line);
+    if (refused == 0)
+        return false;
+    if (refused > 0)
+    {
+        printfUart0("%s is not recorded\r\n", unscriptedCommands[refused]);
+        return true;
+    }
+    while (line[size])
+        size++;
+    if (size == 0)
+        return true;
+    if (scriptLength + size + 1 > SCRIPT_MAX_BYTES)
+    {
+        scriptFull = true;
+        putsUart0("Script full, line not recorded\r\n");
+        return true;
+    }
+    while (*line)
+        appendScriptByte(*line++);
+    appendScriptByte(0);
+    return true;
+}
+
+void endScriptRecord(void)
+{
+    if (!scriptRecording)
+        return;
+    if (scriptLength % 4)
+        writeEeprom(SCRIPT_DATA + scriptLength / 4, scriptWord);
+    writeEeprom(SCRIPT_CRC, scriptCrc);
+    writeEeprom(SCRIPT_HEADER, ((uint32_t)SCRIPT_MAGIC << 16) | scriptLength);
+    scriptRecording = false;
+    printfUart0("Script saved, %d bytes%s\r\n", scriptLength, scriptFull ? " (truncated)" : "");
+}
+
+bool isScriptRecording(void)
+{
+    return scriptRecording;
+}
+
+void clearScript(void)
+{
+    scriptRecording = false;
+    writeEeprom(SCRIPT_HEADER, 0xFFFFFFFF);
+}
+
+// Returns the length of a stored script with a good CRC, 0 otherwise
+uint16_t getScriptLength(void)
+{
+    uint32_t header = readEeprom(SCRIPT_HEADER);
+    uint16_t length = header & 0xFFFF;
+    uint16_t crc = CRC16_INIT;
+    uint16_t i;
+    uint8_t c;
+    if (header >> 16 != SCRIPT_MAGIC || length > SCRIPT_MAX_BYTES)
+        return 0;
+    for (i = 0; i < length; i++)
+    {
+        c = readScriptByte(i);
+        crc = crc16(&c, 1, crc);
+    }
+    if (crc != (readEeprom(SCRIPT_CRC) & 0xFFFF))
+        return 0;
+    return length;
+}
+
+// Runs every stored line as if it had been typed, returns the line count
+uint8_t runScript(void)
+{
+    USER_DATA data;
+    uint16_t length = getScriptLength();
+    uint16_t i;
+    uint8_t lines = 0;
+
+    data.count = 0;
+    for (i = 0; i < length; i++)
+    {
+        data.buffer[data.count] = readScriptByte(i);
+        if (data.buffer[data.count] == 0)
+        {
+            putsUart0("script> ");
+            putsUart0(data.buffer);
+            // Scripts saved before these were refused may still hold them
+            if (findUnscripted(data.buffer) >= 0)
+            {
+                putsUart0(" (skipped)\r\n");
+                data.count = 0;
+                continue;
+            }
+            putsUart0("\r\n");
+            parseField(&data);
+            runCommand(&data);
+            data.count = 0;
+            lines++;
+        }
+        else if (data.count < MAX_CHARS)
+            data.count++;
+    }
+    return lines;
+}
+
+void printScript(void)
+{
+    uint16_t length = getScriptLength();
+    uint16_t i;
+    char c;
+    if (length == 0)
+    {
+        putsUart0("No script stored\r\n");
+        return;
+    }
+    for (i = 0; i < length; i++)
+    {
+        c = readScriptByte(i);
+        if (c)
+            putcUart0(c);
+        else
+            putsUart0("\r\n");
+    }
+}
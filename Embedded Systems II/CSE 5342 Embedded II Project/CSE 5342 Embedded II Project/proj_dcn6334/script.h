@@ -0,0 +1,38 @@
+/*
+ * script.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef SCRIPT_H_
+#define SCRIPT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Internal EEPROM word addresses, words 0-63 are left for the configuration
+#define SCRIPT_BASE         64
+#define SCRIPT_WORDS        448
+#define SCRIPT_MAGIC        0x5343      // "SC"
+// Header word (magic and length), CRC word, then the lines, each ending in 0
+#define SCRIPT_MAX_BYTES    ((SCRIPT_WORDS - 2) * 4)
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void startScriptRecord(void);
+bool recordScriptLine(const char line[]);
+void endScriptRecord(void);
+bool isScriptRecording(void);
+void clearScript(void);
+uint16_t getScriptLength(void);
+uint8_t runScript(void);
+void printScript(void);
+
+#endif
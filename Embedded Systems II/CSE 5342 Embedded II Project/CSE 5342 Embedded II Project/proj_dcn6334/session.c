@@ -0,0 +1,157 @@
+/*
+ * session.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "datalog.h"
+#include "session.h"
+
+#define SESSION_IDLE        0
+#define SESSION_RUNNING     1
+#define SESSION_STOPPING    2
+
+// Room a session keeps for its end record, so it can always be closed
+#define SESSION_END_SIZE    (sizeof(logHeader) + sizeof(sessionSummary))
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint8_t sessionState = SESSION_IDLE;
+uint16_t sessionId = 0;
+sessionHeader session;
+uint32_t sessionSamples;
+uint32_t sessionDropped;
+uint32_t sessionBytesAtStart;
+uint16_t nextSequence;
+bool firstFrame;
+bool sessionLogFull;
+
+// Frames from the gating task waiting to be written by the logging task
+frameRing sessionFrames;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Starts a new session on a fresh log page, returns false if one is running
+// or the log has no room for it
+bool startSession(uint32_t sampleLimit, uint32_t durationMs, uint16_t periodMs, uint32_t now)
+{
+    if (sessionState != SESSION_IDLE)
+        return false;
+
+    alignLog();
+    if (getLogFree() < sizeof(logHeader) + sizeof(session) + SESSION_END_SIZE)
+        return false;
+
+    session.id = ++sessionId;
+    session.periodMs = periodMs;
+    session.startTime = now;
+    session.sampleLimit = sampleLimit;
+    session.durationMs = durationMs;
+    sessionSamples = 0;
+    sessionDropped = 0;
+    firstFrame = true;
+    sessionLogFull = false;
+    frameRingInit(&sessionFrames);
+
+    sessionBytesAtStart = getLogBytesWritten();
+    writeLogRecord(LOG_RECORD_SESSION_START, &session, sizeof(session));
+    sessionState = SESSION_RUNNING;
+    return true;
+}
+
+// Graceful stop, the logging task flushes the remaining frames
+void stopSession(void)
+{
+    if (sessionState == SESSION_RUNNING)
+        sessionState = SESSION_STOPPING;
+}
+
+bool isSessionRunning(void)
+{
+    return sessionState != SESSION_IDLE;
+}
+
+// True if the last session was ended because the log filled up
+bool isSessionLogFull(void)
+{
+    return sessionLogFull;
+}
+
+// Called by the gating task for every frame, returns true when the session
+// has reached its sample count or duration
+bool sessionFrame(const sampleFrame* frame)
+{
+    if (sessionState != SESSION_RUNNING)
+        return false;
+
+    if (session.durationMs && frame->timestamp - session.startTime >= session.durationMs)
+    {
+        sessionState = SESSION_STOPPING;
+        return true;
+    }
+
+    // Gaps in the sequence are frames the acquisition ring had to drop
+    if (!firstFrame)
+        sessionDropped += (uint16_t)(frame->sequence - nextSequence);
+    firstFrame = false;
+    nextSequence = frame->sequence + 1;
+
+    if (frameRingPush(&sessionFrames, frame))
+        sessionSamples++;
+    else
+        sessionDropped++;
+
+    if (session.sampleLimit && sessionSamples >= session.sampleLimit)
+    {
+        sessionState = SESSION_STOPPING;
+        return true;
+    }
+    return false;
+}
+
+// Called by the logging task, writes the queued frames and returns true with
+// the summary filled in once a stopping session has been closed
+bool serviceSession(uint32_t now, sessionSummary* summary)
+{
+    sampleFrame frame;
+
+    // Once the log is full the rest of the frames are dropped and the
+    // session ends
+    while (frameRingPop(&sessionFrames, &frame))
+    {
+        if (!sessionLogFull && getLogFree() >= sizeof(logHeader) + sizeof(frame) + SESSION_END_SIZE)
+            writeLogRecord(LOG_RECORD_FRAME, &frame, sizeof(frame));
+        else
+        {
+            sessionLogFull = true;
+            sessionState = SESSION_STOPPING;
+            sessionSamples--;
+            sessionDropped++;
+        }
+    }
+
+    if (sessionState != SESSION_STOPPING)
+        return false;
+
+    summary->id = session.id;
+    summary->reserved = 0;
+    summary->elapsedMs = now - session.startTime;
+    summary->samples = sessionSamples;
+    summary->dropped = sessionDropped;
+    summary->bytesWritten = getLogBytesWritten() - sessionBytesAtStart + sizeof(logHeader) + sizeof(sessionSummary);
+    writeLogRecord(LOG_RECORD_SESSION_END, summary, sizeof(sessionSummary));
+    alignLog();
+    sessionState = SESSION_IDLE;
+    return true;
+}
@@ -0,0 +1,51 @@
+/*
+ * session.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef SESSION_H_
+#define SESSION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sample.h"
+
+// Written to the log when a session starts
+typedef struct _sessionHeader
+{
+    uint16_t id;
+    uint16_t periodMs;
+    uint32_t startTime;                 // scheduler ticks (ms)
+    uint32_t sampleLimit;               // 0 = no limit
+    uint32_t durationMs;                // 0 = no limit
+} sessionHeader;
+
+// Written to the log when a session ends and reported on the console
+typedef struct _sessionSummary
+{
+    uint16_t id;
+    uint16_t reserved;
+    uint32_t elapsedMs;
+    uint32_t samples;
+    uint32_t dropped;
+    uint32_t bytesWritten;
+} sessionSummary;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+bool startSession(uint32_t sampleLimit, uint32_t durationMs, uint16_t periodMs, uint32_t now);
+void stopSession(void);
+bool isSessionRunning(void);
+bool isSessionLogFull(void);
+bool sessionFrame(const sampleFrame* frame);
+bool serviceSession(uint32_t now, sessionSummary* summary);
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * stream.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart0.h"
+#include "format.h"
+#include "crc16.h"
+#include "stream.h"
+
+// Longest ASCII line: 10 digit timestamp, 5 digit sequence, 7 x -32768
+#define ASCII_LINE_MAX      (10 + 1 + 5 + MAX_CHANNELS * 7 + 2)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint8_t streamMode = STREAM_OFF;
+uint32_t streamSent = 0;
+uint32_t streamDropped = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// Consistent overhead byte stuffing, removes every 0 from the data so the
+// 0 delimiter marks the frame boundaries. Returns the encoded size including
+// the delimiter.
+uint16_t cobsEncode(const uint8_t data[], uint16_t size, uint8_t out[])
+{
+    uint16_t code = 0;                  // index of the current code byte
+    uint16_t n = 1;
+    uint16_t i;
+    for (i = 0; i < size; i++)
+    {
+        if (data[i] == 0)
+        {
+            out[code] = n - code;
+            code = n++;
+        }
+        else
+        {
+            out[n++] = data[i];
+            if (n - code == 0xFF)
+            {
+                out[code] = 0xFF;
+                code = n++;
+            }
+        }
+    }
+    out[code] = n - code;
+    out[n++] = 0;
+    return n;
+}
+
+void setStreamMode(uint8_t mode)
+{
+    streamMode = mode;
+    streamSent = 0;
+    streamDropped = 0;
+}
+
+uint8_t getStreamMode(void)
+{
+    return streamMode;
+}
+
+// Called for every sample frame. A frame that does not fit in the TX ring is
+// dropped rather than holding up the caller, the host sees the gap in the
+// sequence numbers.
+void streamFrame(const sampleFrame* frame)
+{
+    streamPacket packet;
+    uint8_t encoded[COBS_SIZE(sizeof(streamPacket))];
+    uint16_t size;
+    uint8_t i;
+
+    if (streamMode == STREAM_BINARY)
+    {
+        packet.type = STREAM_PACKET_FRAME;
+        packet.channels = MAX_CHANNELS;
+        packet.sequence = frame->sequence;
+        packet.timestamp = frame->timestamp;
+        for (i = 0; i < MAX_CHANNELS; i++)
+            packet.value[i] = frame->value[i];
+        packet.crc = crc16(&packet, sizeof(packet) - sizeof(packet.crc), CRC16_INIT);
+        size = cobsEncode((const uint8_t*)&packet, sizeof(packet), encoded);
+        if (tryWriteUart0(encoded, size))
+            streamSent++;
+        else
+            streamDropped++;
+    }
+    else if (streamMode == STREAM_ASCII)
+    {
+        if (getUart0TxFree() < ASCII_LINE_MAX)
+        {
+            streamDropped++;
+            return;
+        }
+        printfUart0("%u,%u", frame->timestamp, frame->sequence);
+        for (i = 0; i < MAX_CHANNELS; i++)
+            printfUart0(",%d", frame->value[i]);
+        putsUart0("\r\n");
+        streamSent++;
+    }
+}
+
+uint32_t getStreamSent(void)
+{
+    return streamSent;
+}
+
+uint32_t getStreamDropped(void)
+{
+    return streamDropped;
+}
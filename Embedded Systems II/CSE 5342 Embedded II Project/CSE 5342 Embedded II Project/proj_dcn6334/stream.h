@@ -0,0 +1,52 @@
+/*
+ * stream.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef STREAM_H_
+#define STREAM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sample.h"
+
+#define STREAM_OFF          0
+#define STREAM_ASCII        1
+#define STREAM_BINARY       2
+
+#define STREAM_PACKET_FRAME 1
+#define STREAM_PACKET_DUMP  2
+
+// COBS adds one byte per 254 and the frame ends with a 0
+#define COBS_SIZE(n)        ((n) + ((n) / 254) + 2)
+
+// Binary packet before COBS framing, little endian (24 bytes). On the wire
+// it is COBS encoded and followed by a 0 delimiter (26 bytes).
+typedef struct _streamPacket
+{
+    uint8_t type;
+    uint8_t channels;
+    uint16_t sequence;                  // acquisition sequence, gaps are drops
+    uint32_t timestamp;                 // scheduler ticks (ms)
+    int16_t value[MAX_CHANNELS];
+    uint16_t crc;                       // CRC-16/CCITT-FALSE of the bytes above
+} streamPacket;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+uint16_t cobsEncode(const uint8_t data[], uint16_t size, uint8_t out[]);
+void setStreamMode(uint8_t mode);
+uint8_t getStreamMode(void);
+void streamFrame(const sampleFrame* frame);
+uint32_t getStreamSent(void);
+uint32_t getStreamDropped(void);
+
+#endif
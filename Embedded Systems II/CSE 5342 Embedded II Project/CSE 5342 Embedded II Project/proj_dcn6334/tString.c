@@ -7,10 +7,13 @@
 
 #include "tString.h"
 
-// Compares to strings to see if they are equal or not
+// Compares to strings to see if they are equal or not, a missing string
+// (getFieldString of a number field) never matches
 bool stringCompare(const char string1[], const char string2[], uint8_t size)
 {
     uint8_t index = 0;
+    if(string1 == 0 || string2 == 0)
+        return false;
     // The comparison with MAX_CHARS is a bit unnecessary
     while((string1[index] != '\0') && (string2[index] != '\0') && index < size)
     {
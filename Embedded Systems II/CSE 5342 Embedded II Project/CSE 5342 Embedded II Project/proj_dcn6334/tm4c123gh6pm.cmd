@@ -21,7 +21,7 @@ MEMORY
 /* modifications in your CCS project and leave this file alone.              */
 /*                                                                           */
 /* --heap_size=0                                                             */
-/* --stack_size=256                                                          */
+/* --stack_size=12000                                                        */
 /* --library=rtsv7M4_T_le_eabi.lib                                           */
 
 /* Section allocation in memory */
@@ -42,4 +42,7 @@ SECTIONS
     .stack  :   > SRAM
 }
 
-__STACK_TOP = __stack + 512;
+/* The main stack is .stack, sized by --stack_size in the project (12000    */
+/* bytes). Only the handlers and the code before the kernel starts use it,   */
+/* the threads have their own stacks. ps shows the high-water mark of both.  */
+__STACK_TOP = __STACK_END;
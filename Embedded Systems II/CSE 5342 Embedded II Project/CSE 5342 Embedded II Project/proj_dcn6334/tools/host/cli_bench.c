@@ -0,0 +1,114 @@
+/*
+ * cli_bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Replays recorded command logs through getsUart0 and the parser and reports
+// lines per second, for the character-class tokenizer and for the range
+// comparison tokenizer it replaced (cli_legacy.c). "getsUart0" only
+// assembles the lines, so the tokenizer cost is the difference to it. The host
+// only gives relative numbers, the target runs at 40 MHz.
+//
+// usage: cli_bench [LOG...]            default commands.log
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "cli.h"
+#include "host.h"
+
+// Each log is replayed for at least this long
+#define BENCH_NS 500000000
+
+typedef struct _parser
+{
+    const char* name;
+    void (*parse)(USER_DATA* data);
+    int32_t (*integer)(USER_DATA* data, uint8_t fieldNumber);
+} parser;
+
+void legacyParseField(USER_DATA* data);
+int32_t legacyGetFieldInteger(USER_DATA* data, uint8_t fieldNumber);
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const parser parsers[] =
+{
+    {"getsUart0", 0, 0},
+    {"legacy", legacyParseField, legacyGetFieldInteger},
+    {"table", parseField, getFieldInteger},
+};
+
+volatile int32_t benchSink;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// One pass over the log, returns the number of lines
+uint32_t replay(const parser* p, const uint8_t* log, uint32_t size)
+{
+    USER_DATA data;
+    uint32_t lines = 0;
+    uint8_t i;
+    data.count = 0;
+    hostSetInput(log, size);
+    while (getsUart0(&data))
+    {
+        lines++;
+        if (p->parse == 0)
+            continue;
+        p->parse(&data);
+        benchSink += isCommand(&data, "gating", 3);
+        for (i = 1; i < data.fieldCount; i++)
+            benchSink += p->integer(&data, i);
+    }
+    hostResetOutput();
+    return lines;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* defaultLog[] = {"cli_bench", "commands.log"};
+    uint8_t* log;
+    uint32_t size, lines;
+    uint64_t start, elapsed;
+    uint8_t p;
+    int i;
+    if (argc < 2)
+    {
+        argc = 2;
+        argv = (char**)defaultLog;
+    }
+    for (i = 1; i < argc; i++)
+    {
+        if (!readHostFile(argv[i], &log, &size))
+        {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        for (p = 0; p < sizeof(parsers) / sizeof(parsers[0]); p++)
+        {
+            lines = 0;
+            replay(&parsers[p], log, size);
+            start = hostNs();
+            do
+                lines += replay(&parsers[p], log, size);
+            while ((elapsed = hostNs() - start) < BENCH_NS);
+            printf("%s %-9s: %u lines in %.3f s, %.0f lines/s, %.1f ns/line\n", argv[i],
+                   parsers[p].name, lines, elapsed / 1e9, lines * 1e9 / elapsed,
+                   (double)elapsed / lines);
+        }
+        free(log);
+    }
+    return 0;
+}
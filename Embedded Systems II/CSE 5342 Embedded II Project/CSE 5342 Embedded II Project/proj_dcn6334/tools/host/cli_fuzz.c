@@ -0,0 +1,164 @@
+/*
+ * cli_fuzz.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Fuzz target for the CLI parser. The input is fed to getsUart0 as received
+// UART bytes, and every completed line goes through parseField, isCommand,
+// getFieldString and getFieldInteger/getFieldFixed. The same bytes are also
+// parsed as a raw buffer, which reaches characters getsUart0 filters out.
+//
+// Built with -DLIBFUZZER and -fsanitize=fuzzer it is a libFuzzer target.
+// Otherwise main() runs each file named on the command line (or stdin when
+// there are none) once, which is the entry point afl-gcc expects and what
+// "make check" uses to replay the corpus.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include "cli.h"
+#include "host.h"
+
+#define FAIL(...) do { fprintf(stderr, __VA_ARGS__); abort(); } while (0)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const char* fuzzCommands[] = {"ps", "kill", "gating", "trigger", "dump", "baud", "a"};
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+// getFieldInteger worked out with the C library for whole numbers, saturated
+// the same way. Returns false for fixed-point fields, which it does not cover.
+bool referenceInteger(const char* field, int32_t* result)
+{
+    bool negative = false;
+    unsigned long long value;
+    if (strchr(field, '.'))
+        return false;
+    if (*field == '-' || *field == '+')
+        negative = (*field++ == '-');
+    errno = 0;
+    if (field[0] == '0' && (field[1] == 'x' || field[1] == 'X'))
+    {
+        value = strtoull(field + 2, 0, 16);
+        if (errno == ERANGE || value > 0xFFFFFFFF)
+            value = 0xFFFFFFFF;
+    }
+    else
+    {
+        value = strtoull(field, 0, 10);
+        if (errno == ERANGE || value > (negative ? 0x80000000ULL : 0x7FFFFFFFULL))
+            value = negative ? 0x80000000ULL : 0x7FFFFFFFULL;
+    }
+    *result = negative ? (int32_t)(0 - (uint32_t)value) : (int32_t)value;
+    return true;
+}
+
+// The invariants a parsed line has to keep, whatever the bytes were
+void checkLine(USER_DATA* data)
+{
+    char copy[MAX_CHARS + 1];
+    uint8_t i, c;
+    int32_t expected;
+    char* field;
+
+    memcpy(copy, data->buffer, sizeof(copy));
+    parseField(data);
+    if (data->fieldCount > MAX_FIELDS)
+        FAIL("fieldCount %d\n", data->fieldCount);
+    for (i = 0; i < data->fieldCount; i++)
+    {
+        if (data->fieldPosition[i] >= MAX_CHARS)
+            FAIL("field %d at %d\n", i, data->fieldPosition[i]);
+        if (data->fieldType[i] != 'n' && data->fieldType[i] != 'a')
+            FAIL("field %d type %d\n", i, data->fieldType[i]);
+    }
+    for (c = 0; c < sizeof(fuzzCommands) / sizeof(fuzzCommands[0]); c++)
+    {
+        for (i = 0; i <= MAX_FIELDS; i++)
+            isCommand(data, fuzzCommands[c], i);
+    }
+    for (i = 0; i <= MAX_FIELDS + 1; i++)
+    {
+        field = getFieldString(data, i);
+        if (field != 0 && (field < data->buffer || field >= data->buffer + MAX_CHARS))
+            FAIL("field %d outside the buffer\n", i);
+        getFieldFixed(data, i, 3);
+        getFieldFixed(data, i, 255);
+        if (i < data->fieldCount && data->fieldType[i] == 'n')
+        {
+            field = data->buffer + data->fieldPosition[i];
+            if (referenceInteger(field, &expected) && getFieldInteger(data, i) != expected)
+                FAIL("\"%s\" gave %d, expected %d (line \"%s\")\n", field,
+                     getFieldInteger(data, i), expected, copy);
+        }
+    }
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    USER_DATA line;
+    uint32_t raw;
+
+    // As typed at the terminal, the partial line carries over between calls
+    memset(&line, 0, sizeof(line));
+    hostSetInput(data, size);
+    hostResetOutput();
+    while (hostInputLeft())
+    {
+        if (getsUart0(&line))
+            checkLine(&line);
+        if (line.count >= MAX_CHARS)
+            FAIL("count %d\n", line.count);
+    }
+
+    // As a raw buffer, any byte but the terminator
+    raw = size < MAX_CHARS ? size : MAX_CHARS;
+    memset(&line, 0, sizeof(line));
+    memcpy(line.buffer, data, raw);
+    line.buffer[raw] = '\0';
+    checkLine(&line);
+    return 0;
+}
+
+#ifndef LIBFUZZER
+int main(int argc, char* argv[])
+{
+    uint8_t* data;
+    uint32_t size;
+    int i;
+    if (argc < 2)
+    {
+        data = malloc(1 << 16);
+        size = fread(data, 1, 1 << 16, stdin);
+        LLVMFuzzerTestOneInput(data, size);
+        free(data);
+        return 0;
+    }
+    for (i = 1; i < argc; i++)
+    {
+        if (!readHostFile(argv[i], &data, &size))
+        {
+            fprintf(stderr, "cannot read %s\n", argv[i]);
+            return 1;
+        }
+        LLVMFuzzerTestOneInput(data, size);
+        free(data);
+    }
+    printf("%d inputs ok\n", argc - 1);
+    return 0;
+}
+#endif
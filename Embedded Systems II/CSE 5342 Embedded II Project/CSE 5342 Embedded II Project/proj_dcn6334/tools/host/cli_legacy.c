@@ -0,0 +1,72 @@
+/*
+ * cli_legacy.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// parseField and getFieldInteger as they were before the character-class
+// tokenizer, kept so cli_bench can compare the two
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cli.h"
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void legacyParseField(USER_DATA* data)
+{
+    data->fieldCount = 0;
+    bool isNewToken = false;
+    uint8_t i = 0;
+    for(i = 0; (data->buffer[i] != '\0') && (data->fieldCount < MAX_FIELDS); i++)
+    {
+        // Only tokenize alpha numeric characters
+        if(((data->buffer[i] >= 'a' && data->buffer[i] <= 'z') ||
+            (data->buffer[i] >= '0' && data->buffer[i] <= '9') ||
+            (data->buffer[i] >= 'A' && data->buffer[i] <= 'Z') ||
+             data->buffer[i] >= '&') &&
+            !isNewToken)
+        {
+            isNewToken = true;
+            // Record where this new token starts
+            data->fieldPosition[data->fieldCount] = i;
+            if(data->buffer[i] >= '0' && data->buffer[i] <= '9')
+                data->fieldType[data->fieldCount++] = 'n';
+            else
+                data->fieldType[data->fieldCount++] = 'a';
+        }
+        else if(!(data->buffer[i] >= 'a' && data->buffer[i] <= 'z') &&
+                !(data->buffer[i] >= '0' && data->buffer[i] <= '9') &&
+                !(data->buffer[i] >= 'A' && data->buffer[i] <= 'Z') &&
+                !(data->buffer[i] >= '&'))
+        {
+            isNewToken = false;
+            // Replace the delimeters with null terminators
+            data->buffer[i] = '\0';
+        }
+    }
+    return;
+}
+
+// Wraps instead of saturating, the benchmark is built with -fwrapv
+int32_t legacyGetFieldInteger(USER_DATA* data, uint8_t fieldNumber)
+{
+    int32_t signedInteger32bits = 0;
+    if((fieldNumber < MAX_FIELDS) &&
+       (fieldNumber < data->fieldCount) &&
+       (data->fieldType[fieldNumber] == 'n'))
+    {
+         char* numberString = data->buffer + data->fieldPosition[fieldNumber];
+         uint8_t i;
+         for(i = 0; numberString[i] != '\0'; i++)
+             signedInteger32bits = (signedInteger32bits * 10) + (numberString[i] - '0');
+    }
+    return signedInteger32bits;
+}
@@ -0,0 +1,203 @@
+/*
+ * cli_test.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Table-driven checks of the tokenizer, the typed field parsing and the line
+// assembly in getsUart0
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "cli.h"
+#include "host.h"
+
+typedef struct _parseCase
+{
+    const char* line;
+    const char* types;                  // fieldType of each field
+    int32_t values[MAX_FIELDS];         // getFieldInteger, 0 for text
+} parseCase;
+
+typedef struct _fixedCase
+{
+    const char* number;
+    uint8_t scale;
+    int32_t value;
+} fixedCase;
+
+typedef struct _lineCase
+{
+    const char* input;
+    const char* lines[3];               // completed lines, in order
+    const char* echo;
+} lineCase;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+const parseCase parseCases[] =
+{
+    {"", "", {0}},
+    {"  ps  ", "a", {0}},
+    {"gating temp LT -5", "aaan", {0, 0, 0, -5}},
+    {"gating gyro GT +20 3", "aaann", {0, 0, 0, 20, 3}},
+    {"dump 0x1F 0XfF 007", "annn", {0, 31, 255, 7}},
+    {"a -0x10 -0", "ann", {0, -16, 0}},
+    {"a 1.5 .5 5. -.5", "annnn", {0, 1, 0, 5, 0}},
+    {"- + . 0x 1.2.3", "aaaaa", {0}},
+    {"a 12ab 0x1g 1-2 --1", "aaaaa", {0}},
+    {"a,b;c=d", "aaaa", {0}},
+    {"trigger pin on & x_y", "aaaaa", {0}},
+    {"a\xff" "b\x80" "1", "aan", {0, 0, 1}},
+    {"a 1 2 3 4 5 6", "annnn", {0, 1, 2, 3, 4}},
+    // Saturation
+    {"a 2147483647 2147483648", "ann", {0, 2147483647, 2147483647}},
+    {"a -2147483648 -2147483649", "ann", {0, INT32_MIN, INT32_MIN}},
+    {"a 99999999999999999999", "an", {0, 2147483647}},
+    {"a 0xFFFFFFFF 0x100000000", "ann", {0, -1, -1}},
+    {"a 0x7FFFFFFF 0x80000000", "ann", {0, 2147483647, INT32_MIN}},
+};
+
+const fixedCase fixedCases[] =
+{
+    {"-2.5", 2, -250},
+    {"1.999", 2, 199},
+    {"3", 3, 3000},
+    {"0.05", 1, 0},
+    {".25", 2, 25},
+    {"2147483.647", 3, 2147483647},
+    {"2147483.648", 3, 2147483647},
+    {"-2147483.648", 3, INT32_MIN},
+    {"-2147483.649", 3, INT32_MIN},
+    {"0x10", 2, 1600},
+    {"1.5", 12, 2147483647},
+};
+
+const lineCase lineCases[] =
+{
+    {"ps\r", {"ps"}, "ps\r\n"},
+    {"ab\bc\n", {"ac"}, "ab\b \bc\r\n"},
+    {"\b\x7fps\r", {"ps"}, "ps\r\n"},
+    {"p\x01s\tx\r", {"psx"}, "psx\r\n"},
+    {"a\rb\r", {"a", "b"}, "a\r\nb\r\n"},
+    {"ps", {0}, "ps"},
+};
+
+uint16_t failures = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void check(bool ok, const char* what, const char* line)
+{
+    if (!ok)
+    {
+        printf("FAIL %s: \"%s\"\n", what, line);
+        failures++;
+    }
+}
+
+void testParse(const parseCase* c)
+{
+    USER_DATA data;
+    uint8_t i, n = strlen(c->types);
+    strcpy(data.buffer, c->line);
+    parseField(&data);
+    check(data.fieldCount == n, "field count", c->line);
+    for (i = 0; i < n && i < data.fieldCount; i++)
+    {
+        check(data.fieldType[i] == c->types[i], "field type", c->line);
+        check(getFieldInteger(&data, i) == c->values[i], "integer", c->line);
+        check((getFieldString(&data, i) != 0) == (c->types[i] == 'a'), "string", c->line);
+    }
+    check(getFieldString(&data, n) == 0 && getFieldInteger(&data, n) == 0, "past the end", c->line);
+}
+
+void testFixed(const fixedCase* c)
+{
+    USER_DATA data;
+    char line[MAX_CHARS + 1];
+    snprintf(line, sizeof(line), "x %s", c->number);
+    strcpy(data.buffer, line);
+    parseField(&data);
+    check(getFieldFixed(&data, 1, c->scale) == c->value, "fixed", line);
+}
+
+// The input arrives in one go and again a byte per call, which has to give
+// the same lines
+void testLine(const lineCase* c)
+{
+    USER_DATA data;
+    uint32_t size = strlen(c->input), i, step;
+    uint8_t n;
+    for (step = 0; step < 2; step++)
+    {
+        memset(&data, 0, sizeof(data));
+        hostResetOutput();
+        n = 0;
+        for (i = 0; i < size; i += step ? 1 : size)
+        {
+            hostSetInput(c->input + i, step ? 1 : size);
+            while (getsUart0(&data))
+            {
+                check(n < 3 && c->lines[n] != 0 && strcmp(data.buffer, c->lines[n]) == 0,
+                      "line", c->input);
+                n++;
+            }
+        }
+        check(n == 3 || c->lines[n] == 0, "line count", c->input);
+        check(strcmp(hostOutput, c->echo) == 0, "echo", c->input);
+    }
+}
+
+// A full buffer ends the line, the rest starts the next one
+void testLongLine(void)
+{
+    USER_DATA data;
+    char input[MAX_CHARS + 8];
+    memset(input, 'x', sizeof(input));
+    input[sizeof(input) - 1] = '\r';
+    memset(&data, 0, sizeof(data));
+    hostSetInput(input, sizeof(input));
+    check(getsUart0(&data) && strlen(data.buffer) == MAX_CHARS, "full line", "x * 87");
+    check(getsUart0(&data) && strlen(data.buffer) == sizeof(input) - MAX_CHARS - 1,
+          "rest of the line", "x * 87");
+}
+
+void testCommand(void)
+{
+    USER_DATA data;
+    data.fieldCount = 0;
+    check(!isCommand(&data, "ps", 0), "empty line", "");
+    strcpy(data.buffer, "kill 3");
+    parseField(&data);
+    check(isCommand(&data, "kill", 1), "command", "kill 3");
+    check(!isCommand(&data, "kill", 2), "too few arguments", "kill 3");
+    check(!isCommand(&data, "kil", 0), "prefix", "kill 3");
+}
+
+int main(void)
+{
+    uint16_t i, total = 0;
+    for (i = 0; i < sizeof(parseCases) / sizeof(parseCases[0]); i++, total++)
+        testParse(&parseCases[i]);
+    for (i = 0; i < sizeof(fixedCases) / sizeof(fixedCases[0]); i++, total++)
+        testFixed(&fixedCases[i]);
+    for (i = 0; i < sizeof(lineCases) / sizeof(lineCases[0]); i++, total++)
+        testLine(&lineCases[i]);
+    testLongLine();
+    testCommand();
+    total += 2;
+    printf("%d cases, %d failures\n", total, failures);
+    return failures != 0;
+}
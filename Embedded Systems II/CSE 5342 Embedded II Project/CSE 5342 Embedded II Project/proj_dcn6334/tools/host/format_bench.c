@@ -0,0 +1,171 @@
+/*
+ * format_bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// printfUart0 against what it replaced, sprintf into char x[128] followed by
+// putsUart0, for lines the firmware prints. Both write into the host UART
+// stub. Reports the time per line (TSC cycles on x86) and the stack each one
+// needs, measured by running it on a painted stack. The host C library is
+// not the TI one, so the sprintf numbers only show the order of magnitude;
+// cli.c notes stdio needs 4096 bytes of stack on the target.
+//
+// It also runs sample frames through streamFrame in the text and binary
+// modes, and reports the bytes per frame and the frames per second each mode
+// fits into a 115200 baud console (10 bits per byte on the wire).
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <ucontext.h>
+#include "uart0.h"
+#include "format.h"
+#include "sample.h"
+#include "stream.h"
+#include "host.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES() __rdtsc()
+#else
+#define CYCLES() 0
+#endif
+
+#define ROUNDS          200000
+#define FRAMES          200000
+#define CONSOLE_BAUD    115200
+#define STACK_SIZE      65536
+#define STACK_PAINT     0xA5
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+uint8_t paintedStack[STACK_SIZE];
+ucontext_t benchContext, lineContext;
+bool stackFixed;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void sprintfUart0(const char format[], ...)
+{
+    char x[128];
+    va_list args;
+    va_start(args, format);
+    vsprintf(x, format, args);
+    va_end(args);
+    putsUart0(x);
+}
+
+// The same lines through either formatter, fixed selects printfUart0 and its
+// fixed-point conversion
+void printLines(bool fixed)
+{
+    void (*out)(const char format[], ...) = fixed ? printfUart0 : sprintfUart0;
+    out("Temperature value is: %d\r\n", 23);
+    out("Magnetometer: x = %hu, y = %hu, z = %hu\r\n", 120, 65000, 7);
+    out("%-4d %-12s %d/%d   %-8s ", 2, "acquire", 1, 1, "ready");
+    if (fixed)
+        printfUart0("Session %d: %d samples in %d ms (%.2k Hz), %d dropped\r\n", 4, 1000, 10012, 9988, 0);
+    else
+        sprintfUart0("Session %d: %d samples in %d ms (%.2f Hz), %d dropped\r\n", 4, 1000, 10012, 99.88, 0);
+    out("Baud %d: IBRD %d, FBRD %d, HSE %d\r\n", 115190, 21, 45, 0);
+}
+
+void runOnPaintedStack(void)
+{
+    printLines(stackFixed);
+}
+
+uint32_t stackUsed(bool fixed)
+{
+    uint32_t i;
+    memset(paintedStack, STACK_PAINT, sizeof(paintedStack));
+    getcontext(&lineContext);
+    lineContext.uc_stack.ss_sp = paintedStack;
+    lineContext.uc_stack.ss_size = sizeof(paintedStack);
+    lineContext.uc_link = &benchContext;
+    makecontext(&lineContext, runOnPaintedStack, 0);
+    stackFixed = fixed;
+    swapcontext(&benchContext, &lineContext);
+    for (i = 0; i < STACK_SIZE && paintedStack[i] == STACK_PAINT; i++);
+    return STACK_SIZE - i;
+}
+
+void bench(const char* name, bool fixed)
+{
+    uint64_t start, cycles, ns;
+    uint32_t round;
+    printLines(fixed);
+    hostResetOutput();
+    start = hostNs();
+    cycles = CYCLES();
+    for (round = 0; round < ROUNDS; round++)
+    {
+        printLines(fixed);
+        hostOutputLength = 0;
+    }
+    cycles = CYCLES() - cycles;
+    ns = hostNs() - start;
+    printf("%-12s %7.1f ns/line", name, (double)ns / ROUNDS / 5);
+    if (cycles)
+        printf(" %7.1f cycles/line", (double)cycles / ROUNDS / 5);
+    printf(", %u bytes of stack\n", stackUsed(fixed));
+}
+
+// Frames with values of every width, like a moving sensor
+void fillFrame(sampleFrame* frame, uint32_t n)
+{
+    uint8_t i;
+    frame->timestamp = 1000 + n * 10;
+    frame->sequence = n;
+    for (i = 0; i < MAX_CHANNELS; i++)
+        frame->value[i] = (int16_t)((n * 2654435761u) >> (i * 3 + 8)) >> (n % 12);
+}
+
+void benchStream(const char* name, uint8_t mode)
+{
+    sampleFrame frame;
+    uint64_t start, cycles, ns, bytes;
+    uint32_t n;
+    setStreamMode(mode);
+    hostResetOutput();
+    hostOutputTotal = 0;
+    start = hostNs();
+    cycles = CYCLES();
+    for (n = 0; n < FRAMES; n++)
+    {
+        fillFrame(&frame, n);
+        streamFrame(&frame);
+        hostOutputLength = 0;
+    }
+    cycles = CYCLES() - cycles;
+    ns = hostNs() - start;
+    bytes = hostOutputTotal;
+    printf("%-12s %7.1f ns/frame", name, (double)ns / FRAMES);
+    if (cycles)
+        printf(" %7.1f cycles/frame", (double)cycles / FRAMES);
+    printf(", %5.1f bytes/frame, %4.0f frames/s at %d baud\n", (double)bytes / FRAMES,
+           (double)CONSOLE_BAUD / 10 * FRAMES / bytes, CONSOLE_BAUD);
+}
+
+int main(void)
+{
+    printLines(true);
+    printf("%s", hostOutput);
+    bench("sprintf", false);
+    bench("printfUart0", true);
+    benchStream("stream text", STREAM_ASCII);
+    benchStream("stream bin", STREAM_BINARY);
+    return 0;
+}
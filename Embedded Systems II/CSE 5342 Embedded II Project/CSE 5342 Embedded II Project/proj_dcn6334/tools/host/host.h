@@ -0,0 +1,45 @@
+/*
+ * host.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Linux build of the target-independent modules. uart0_host.c stands in for
+// the UART0 driver: received bytes come from a buffer set with hostSetInput
+// and transmitted bytes are counted (and kept in hostOutput for tests).
+
+#ifndef HOST_H_
+#define HOST_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#define HOST_OUTPUT_SIZE 4096
+
+extern char hostOutput[HOST_OUTPUT_SIZE];
+extern uint32_t hostOutputLength;
+extern uint64_t hostOutputTotal;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void hostSetInput(const void* data, uint32_t size);
+uint32_t hostInputLeft(void);
+void hostResetOutput(void);
+bool readHostFile(const char* name, uint8_t** data, uint32_t* size);
+
+static inline uint64_t hostNs(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * kernel_host.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Empty kernel and GPIO calls so cli.c links on the host, the thread and IPC
+// listings are not exercised there
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+#include "kernel.h"
+#include "ipc.h"
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void enablePort(PORT port)
+{
+}
+
+void selectPinPushPullOutput(PORT port, uint8_t pin)
+{
+}
+
+void setPinValue(PORT port, uint8_t pin, bool value)
+{
+}
+
+uint32_t getMainStackUsed(void)
+{
+    return 0;
+}
+
+uint32_t getMainStackSize(void)
+{
+    return 0;
+}
+
+uint32_t getStackPoolUsed(void)
+{
+    return 0;
+}
+
+bool killThread(int8_t pid)
+{
+    return false;
+}
+
+int8_t getPid(const char name[])
+{
+    return -1;
+}
+
+bool getThreadInfo(int8_t pid, threadInfo* info)
+{
+    return false;
+}
+
+void resetThreadCpu(void)
+{
+}
+
+void setPriorityScheduling(bool on)
+{
+}
+
+void setPreemption(bool on)
+{
+}
+
+void setPriorityInheritance(bool on)
+{
+}
+
+mutex* getMutexList(void)
+{
+    return 0;
+}
+
+ipcObject* getIpcList(void)
+{
+    return 0;
+}
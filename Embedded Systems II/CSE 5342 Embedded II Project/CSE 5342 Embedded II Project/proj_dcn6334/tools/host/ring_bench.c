@@ -0,0 +1,117 @@
+/*
+ * ring_bench.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// Cost of a ringbuf.h push and pop for the byte rings of uart0.c and the
+// frame ring of sample.h, in ns and, on x86, in TSC cycles. The ring is
+// filled and drained from one thread, so this is the uncontended cost; the
+// barrier is an mfence here and a DMB on the target.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "sample.h"
+#include "host.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CYCLES() __rdtsc()
+#else
+#define CYCLES() 0
+#endif
+
+#define ROUNDS 200000
+
+RING_BUFFER(byteRing, uint8_t, 256)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+byteRing bytes;
+frameRing frames;
+volatile uint32_t benchSink;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void report(const char* name, uint64_t operations, uint64_t ns, uint64_t cycles)
+{
+    printf("%-12s %6.2f ns", name, (double)ns / operations);
+    if (cycles)
+        printf(" %6.1f cycles", (double)cycles / operations);
+    printf("\n");
+}
+
+void benchBytes(void)
+{
+    uint64_t ns[2] = {0}, cycles[2] = {0}, t, c;
+    uint32_t round, i;
+    uint8_t b = 0;
+    byteRingInit(&bytes);
+    for (round = 0; round < ROUNDS; round++)
+    {
+        t = hostNs();
+        c = CYCLES();
+        for (i = 0; i < 256; i++, b++)
+            byteRingPush(&bytes, &b);
+        cycles[0] += CYCLES() - c;
+        ns[0] += hostNs() - t;
+        t = hostNs();
+        c = CYCLES();
+        for (i = 0; i < 256; i++)
+        {
+            byteRingPop(&bytes, &b);
+            benchSink += b;
+        }
+        cycles[1] += CYCLES() - c;
+        ns[1] += hostNs() - t;
+    }
+    report("byte push", (uint64_t)ROUNDS * 256, ns[0], cycles[0]);
+    report("byte pop", (uint64_t)ROUNDS * 256, ns[1], cycles[1]);
+}
+
+void benchFrames(void)
+{
+    uint64_t ns[2] = {0}, cycles[2] = {0}, t, c;
+    uint32_t round, i;
+    sampleFrame frame = {0};
+    frameRingInit(&frames);
+    for (round = 0; round < ROUNDS; round++)
+    {
+        t = hostNs();
+        c = CYCLES();
+        for (i = 0; i < FRAME_RING_SIZE; i++, frame.sequence++)
+            frameRingPush(&frames, &frame);
+        cycles[0] += CYCLES() - c;
+        ns[0] += hostNs() - t;
+        t = hostNs();
+        c = CYCLES();
+        for (i = 0; i < FRAME_RING_SIZE; i++)
+        {
+            frameRingPop(&frames, &frame);
+            benchSink += frame.sequence;
+        }
+        cycles[1] += CYCLES() - c;
+        ns[1] += hostNs() - t;
+    }
+    report("frame push", (uint64_t)ROUNDS * FRAME_RING_SIZE, ns[0], cycles[0]);
+    report("frame pop", (uint64_t)ROUNDS * FRAME_RING_SIZE, ns[1], cycles[1]);
+}
+
+int main(void)
+{
+    benchBytes();
+    benchFrames();
+    if (bytes.overflow || frames.overflow)
+        printf("unexpected overflow\n");
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * ring_test.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+// SPSC stress test of ringbuf.h: a producer thread and a consumer thread
+// pass a numbered stream through the frame ring of sample.h and through a
+// byte ring sized like the UART rings. The consumer checks that every item
+// arrives once, in order and intact. A full ring makes the producer retry,
+// so nothing may be lost. Waiting threads yield, which also makes the test
+// usable on a single core, where it preempts like an ISR on the target.
+//
+// usage: ring_test [ITEMS]            default 1000000 per ring
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include "sample.h"
+
+#define DEFAULT_ITEMS 1000000
+
+RING_BUFFER(byteRing, uint8_t, 256)
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+frameRing frames;
+byteRing bytes;
+uint32_t items = DEFAULT_ITEMS;
+uint32_t errors = 0;
+uint64_t fullRetries = 0;
+uint64_t emptyRetries = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void makeFrame(sampleFrame* frame, uint32_t n)
+{
+    uint8_t i;
+    frame->timestamp = n;
+    frame->sequence = n;
+    for (i = 0; i < MAX_CHANNELS; i++)
+        frame->value[i] = n * 31 + i;
+}
+
+void* frameProducer(void* arg)
+{
+    sampleFrame frame;
+    uint32_t n;
+    for (n = 0; n < items; n++)
+    {
+        makeFrame(&frame, n);
+        while (!frameRingPush(&frames, &frame))
+        {
+            fullRetries++;
+            sched_yield();
+        }
+    }
+    return 0;
+}
+
+void* frameConsumer(void* arg)
+{
+    sampleFrame frame, expected;
+    uint32_t n;
+    for (n = 0; n < items; n++)
+    {
+        while (!frameRingPop(&frames, &frame))
+        {
+            emptyRetries++;
+            sched_yield();
+        }
+        makeFrame(&expected, n);
+        if (memcmp(&frame, &expected, sizeof(frame)) != 0 && errors++ < 10)
+            printf("frame %u: got %u\n", n, frame.timestamp);
+    }
+    return 0;
+}
+
+void* byteProducer(void* arg)
+{
+    uint32_t n;
+    uint8_t b;
+    for (n = 0; n < items; n++)
+    {
+        b = n * 7;
+        while (!byteRingPush(&bytes, &b))
+            sched_yield();
+    }
+    return 0;
+}
+
+void* byteConsumer(void* arg)
+{
+    uint32_t n;
+    uint8_t b;
+    for (n = 0; n < items; n++)
+    {
+        while (!byteRingPop(&bytes, &b))
+            sched_yield();
+        if (b != (uint8_t)(n * 7) && errors++ < 10)
+            printf("byte %u: got %u\n", n, b);
+    }
+    return 0;
+}
+
+void runPair(const char* name, void* (*producer)(void*), void* (*consumer)(void*),
+             uint32_t (*count)(void*), void* ring)
+{
+    pthread_t p, c;
+    pthread_create(&c, 0, consumer, 0);
+    pthread_create(&p, 0, producer, 0);
+    pthread_join(p, 0);
+    pthread_join(c, 0);
+    printf("%s: %u items, %u left in the ring\n", name, items, count(ring));
+    if (count(ring) != 0)
+        errors++;
+}
+
+uint32_t frameCount(void* ring)
+{
+    return frameRingCount(ring);
+}
+
+uint32_t byteCount(void* ring)
+{
+    return byteRingCount(ring);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc > 1)
+        items = strtoul(argv[1], 0, 0);
+    frameRingInit(&frames);
+    byteRingInit(&bytes);
+    runPair("frames", frameProducer, frameConsumer, frameCount, &frames);
+    runPair("bytes", byteProducer, byteConsumer, byteCount, &bytes);
+    printf("%llu full and %llu empty retries on the frame ring, %u errors\n",
+           (unsigned long long)fullRetries, (unsigned long long)emptyRetries, errors);
+    return errors != 0;
+}
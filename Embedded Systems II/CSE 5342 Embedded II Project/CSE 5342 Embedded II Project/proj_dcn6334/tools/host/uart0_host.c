@@ -0,0 +1,126 @@
+/*
+ * uart0_host.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "uart0.h"
+#include "host.h"
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// Byte source for getsUart0
+const uint8_t* hostInput = 0;
+uint32_t hostInputSize = 0;
+uint32_t hostInputPosition = 0;
+
+// Byte sink, the start of the output is kept for tests
+char hostOutput[HOST_OUTPUT_SIZE];
+uint32_t hostOutputLength = 0;
+uint64_t hostOutputTotal = 0;
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void hostSetInput(const void* data, uint32_t size)
+{
+    hostInput = data;
+    hostInputSize = size;
+    hostInputPosition = 0;
+}
+
+uint32_t hostInputLeft(void)
+{
+    return hostInputSize - hostInputPosition;
+}
+
+void hostResetOutput(void)
+{
+    hostOutputLength = 0;
+    hostOutput[0] = '\0';
+}
+
+bool readHostFile(const char* name, uint8_t** data, uint32_t* size)
+{
+    FILE* f = fopen(name, "rb");
+    long length;
+    if (f == 0)
+        return false;
+    fseek(f, 0, SEEK_END);
+    length = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    *data = malloc(length + 1);
+    *size = fread(*data, 1, length, f);
+    fclose(f);
+    return true;
+}
+
+void initUart0()
+{
+}
+
+void setUart0BaudRate(uint32_t baudRate, uint32_t fcyc)
+{
+}
+
+bool tryGetcUart0(char* c)
+{
+    if (hostInputPosition == hostInputSize)
+        return false;
+    *c = hostInput[hostInputPosition++];
+    return true;
+}
+
+bool kbhitUart0()
+{
+    return hostInputPosition < hostInputSize;
+}
+
+// Does not block, an exhausted source reads as a carriage return
+char getcUart0()
+{
+    char c;
+    return tryGetcUart0(&c) ? c : '\r';
+}
+
+void putcUart0(char c)
+{
+    if (hostOutputLength < HOST_OUTPUT_SIZE - 1)
+    {
+        hostOutput[hostOutputLength++] = c;
+        hostOutput[hostOutputLength] = '\0';
+    }
+    hostOutputTotal++;
+}
+
+void putsUart0(const char* str)
+{
+    while (*str)
+        putcUart0(*str++);
+}
+
+// The host TX ring never fills
+bool tryWriteUart0(const void* data, uint16_t size)
+{
+    const char* bytes = data;
+    while (size--)
+        putcUart0(*bytes++);
+    return true;
+}
+
+uint32_t getUart0TxFree()
+{
+    return HOST_OUTPUT_SIZE;
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+#
+# stream_decode.py
+#
+#  Created on: Oct 19, 2026
+#      Author: dnwae
+#
+# Decodes the "stream bin" telemetry of proj_dcn6334 into CSV:
+#   timestamp,sequence,temp,gyro_x,gyro_y,gyro_z,accel_x,accel_y,accel_z
+# and the chunks of "dump bin" into an EEPROM image (--dump).
+#
+# Packets are COBS encoded and end with a 0 byte. Each holds a streamPacket
+# (stream.h) with a CRC-16/CCITT-FALSE. Console text that is mixed into the
+# stream fails the CRC and is counted as bad. Gaps in the sequence numbers are
+# reported as dropped frames.
+#
+# usage: stream_decode.py PORT|FILE [--baud 115200] [--out samples.csv]
+#                        [--dump eeprom.bin]
+
+import argparse
+import os
+import stat
+import struct
+import sys
+
+PACKET_FRAME = 1
+PACKET_DUMP = 2
+PACKET_FORMAT = '<BBHI7hH'
+PACKET_SIZE = struct.calcsize(PACKET_FORMAT)
+DUMP_HEADER_FORMAT = '<BBHI'
+DUMP_HEADER_SIZE = struct.calcsize(DUMP_HEADER_FORMAT)
+CHANNELS = ['temp', 'gyro_x', 'gyro_y', 'gyro_z', 'accel_x', 'accel_y', 'accel_z']
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Decoder:
+    def __init__(self, writer, image=None):
+        self.writer = writer
+        self.image = image
+        self.dumped = 0
+        self.buffer = bytearray()
+        self.next_sequence = None
+        self.frames = 0
+        self.dropped = 0
+        self.bad = 0
+
+    def feed(self, data):
+        self.buffer += data
+        while True:
+            end = self.buffer.find(b'\0')
+            if end < 0:
+                return
+            self.packet(bytes(self.buffer[:end]))
+            del self.buffer[:end + 1]
+
+    def packet(self, encoded):
+        if not encoded:
+            return
+        data = cobs_decode(encoded)
+        if data and data[0] == PACKET_DUMP:
+            self.dump(data)
+            return
+        if data is None or len(data) != PACKET_SIZE:
+            self.bad += 1
+            return
+        fields = struct.unpack(PACKET_FORMAT, data)
+        if fields[-1] != crc16(data[:-2]) or fields[0] != PACKET_FRAME:
+            self.bad += 1
+            return
+        sequence, timestamp, values = fields[2], fields[3], fields[4:4 + fields[1]]
+        if self.next_sequence is not None and sequence != self.next_sequence:
+            self.dropped += (sequence - self.next_sequence) & 0xFFFF
+        self.next_sequence = (sequence + 1) & 0xFFFF
+        self.frames += 1
+        self.writer.write('%d,%d,%s\n' % (timestamp, sequence, ','.join(str(v) for v in values)))
+
+
+    def dump(self, data):
+        if len(data) < DUMP_HEADER_SIZE + 2 or struct.unpack('<H', data[-2:])[0] != crc16(data[:-2]):
+            self.bad += 1
+            return
+        _, _, size, address = struct.unpack(DUMP_HEADER_FORMAT, data[:DUMP_HEADER_SIZE])
+        if size != len(data) - DUMP_HEADER_SIZE - 2:
+            self.bad += 1
+            return
+        if self.image:
+            self.image.seek(address)
+            self.image.write(data[DUMP_HEADER_SIZE:-2])
+        self.dumped += size
+
+
+# A tty opens as a plain file too, but then keeps its termios settings (a
+# cooked port turns 0x0D into 0x0A and breaks the CRC), so only regular
+# capture files are opened directly
+def open_input(name, baud):
+    if name.upper().startswith('COM') or (os.path.exists(name) and
+                                          stat.S_ISCHR(os.stat(name).st_mode)):
+        import serial
+        return serial.Serial(name, baud, timeout=0.5)
+    return open(name, 'rb')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the stream bin telemetry into CSV')
+    parser.add_argument('input', help='serial port or captured file')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--out', help='CSV file, default stdout')
+    parser.add_argument('--dump', help='EEPROM image written from dump packets')
+    args = parser.parse_args()
+
+    writer = open(args.out, 'w') if args.out else sys.stdout
+    writer.write('timestamp,sequence,%s\n' % ','.join(CHANNELS))
+    decoder = Decoder(writer, open(args.dump, 'wb') if args.dump else None)
+    source = open_input(args.input, args.baud)
+    try:
+        while True:
+            data = source.read(4096)
+            if not data:
+                if not hasattr(source, 'in_waiting'):
+                    break
+                continue
+            decoder.feed(data)
+    except KeyboardInterrupt:
+        pass
+    sys.stderr.write('%d frames, %d dropped, %d dump bytes, %d bad packets\n'
+                     % (decoder.frames, decoder.dropped, decoder.dumped, decoder.bad))
+
+
+if __name__ == '__main__':
+    main()
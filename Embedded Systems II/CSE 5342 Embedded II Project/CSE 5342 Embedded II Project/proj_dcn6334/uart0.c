@@ -22,15 +22,44 @@
 #include <stdbool.h>
 #include "tm4c123gh6pm.h"
 #include "uart0.h"
+#include "ringbuf.h"
+#include "udma.h"
 
 // PortA masks
 #define UART_TX_MASK 2
 #define UART_RX_MASK 1
 
+// Software FIFOs behind the 16-byte hardware FIFOs
+#define TX_RING_SIZE 1024
+#define RX_RING_SIZE 64
+
+RING_BUFFER(uartTxRing, char, TX_RING_SIZE)
+RING_BUFFER(uartRxRing, char, RX_RING_SIZE)
+
 //-----------------------------------------------------------------------------
 // Global variables
 //-----------------------------------------------------------------------------
 
+// The foreground fills txRing and the ISR drains it, the ISR fills rxRing
+uartTxRing txRing;
+uartRxRing rxRing;
+
+// Times putcUart0 had to wait for room in txRing
+uint32_t txStalls = 0;
+
+// Called from the ISR when bytes arrive
+_uartFn rxCallback = 0;
+
+// Bulk transmit by uDMA, in chunks of up to UDMA_MAX_TRANSFER bytes. The
+// TX ring is held back until it completes.
+bool dmaBusy = false;
+const uint8_t* dmaData;
+uint32_t dmaRemaining;
+_uartFn dmaCallback = 0;
+
+// Divisor programmed by initUart0 (115200 baud at 40 MHz)
+baudSetting currentBaud = {21, 45, false, 115190};
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
@@ -67,28 +96,207 @@ void initUart0()
     UART0_LCRH_R = UART_LCRH_WLEN_8 | UART_LCRH_FEN;    // configure for 8N1 w/ 16-level FIFO
     UART0_CTL_R = UART_CTL_TXE | UART_CTL_RXE | UART_CTL_UARTEN;
                                                         // enable TX, RX, and module
+
+    // Interrupt driven: RX at half full or after a receive time-out, TX when
+    // the FIFO drains below half full
+    uartTxRingInit(&txRing);
+    uartRxRingInit(&rxRing);
+    UART0_ICR_R = UART_ICR_TXIC | UART_ICR_RXIC | UART_ICR_RTIC;
+    UART0_IM_R = UART_IM_RXIM | UART_IM_RTIM | UART_IM_TXIM;
+    NVIC_EN0_R |= 1 << (INT_UART0 - 16);                // turn-on interrupt 21 (UART0)
+}
+
+void startUart0DmaChunk()
+{
+    uint16_t chunk = (dmaRemaining > UDMA_MAX_TRANSFER) ? UDMA_MAX_TRANSFER : dmaRemaining;
+    startDmaToPeripheral(UDMA_CH_UART0_TX, dmaData, &UART0_DR_R, chunk);
+    dmaData += chunk;
+    dmaRemaining -= chunk;
+}
+
+// Moves bytes from txRing into the hardware FIFO. The TX interrupt only
+// fires on the FIFO level falling through the trigger, so the FIFO is
+// always topped up here rather than waiting for the interrupt.
+void fillUart0TxFifo()
+{
+    char c;
+    if (dmaBusy)
+        return;
+    while (!(UART0_FR_R & UART_FR_TXFF) && uartTxRingPop(&txRing, &c))
+        UART0_DR_R = c;
+}
+
+void uart0Isr()
+{
+    char c;
+    bool received = false;
+    UART0_ICR_R = UART_ICR_TXIC | UART_ICR_RXIC | UART_ICR_RTIC;
+    while (!(UART0_FR_R & UART_FR_RXFE))
+    {
+        c = UART0_DR_R & 0xFF;
+        uartRxRingPush(&rxRing, &c);                     // counts an overflow when full
+        received = true;
+    }
+    // uDMA completion comes in through this interrupt
+    if (dmaBusy && isDmaComplete(UDMA_CH_UART0_TX))
+    {
+        clearDmaComplete(UDMA_CH_UART0_TX);
+        if (dmaRemaining)
+            startUart0DmaChunk();
+        else
+        {
+            UART0_DMACTL_R &= ~UART_DMACTL_TXDMAE;
+            dmaBusy = false;
+            if (dmaCallback)
+                dmaCallback();
+        }
+    }
+    fillUart0TxFifo();
+    if (received && rxCallback)
+        rxCallback();
+}
+
+void setUart0RxCallback(_uartFn fn)
+{
+    rxCallback = fn;
+}
+
+// Sends a buffer by uDMA after whatever is queued in the TX ring, the
+// buffer must stay valid until callback runs (from the ISR). Returns false
+// if a transfer is already running.
+bool writeUart0Dma(const void* data, uint32_t size, _uartFn callback)
+{
+    uint32_t key;
+    if (dmaBusy || size == 0)
+        return false;
+    while (uartTxRingCount(&txRing) != 0);
+    key = _disable_interrupts();
+    dmaData = (const uint8_t*)data;
+    dmaRemaining = size;
+    dmaCallback = callback;
+    dmaBusy = true;
+    clearDmaComplete(UDMA_CH_UART0_TX);
+    startUart0DmaChunk();
+    UART0_DMACTL_R |= UART_DMACTL_TXDMAE;
+    _restore_interrupts(key);
+    return true;
+}
+
+bool isUart0DmaBusy()
+{
+    return dmaBusy;
 }
 
 // Set baud rate as function of instruction cycle frequency
+// Divisor r = fcyc / (N x baud) in units of 1/64 with N = 16, or N = 8 in
+// high-speed mode. Returns the resulting rate, 0 if it is out of range.
+uint32_t calcUart0Divisor(uint32_t baudRate, uint32_t fcyc, bool hse, baudSetting* setting)
+{
+    uint32_t divisorTimes64 = ((fcyc * (hse ? 8 : 4)) + baudRate / 2) / baudRate;
+    if (divisorTimes64 < 64 || divisorTimes64 >> 6 > 0xFFFF)
+        return 0;
+    setting->ibrd = divisorTimes64 >> 6;                // floor(r)
+    setting->fbrd = divisorTimes64 & 63;                // round(fract(r)*64)
+    setting->hse = hse;
+    setting->actual = (fcyc * (hse ? 8 : 4)) / divisorTimes64;
+    return setting->actual;
+}
+
+// Picks the divisor with the smaller rate error, 16x oversampling on a tie
+// since it tolerates more clock mismatch. Returns false if neither works.
+bool findUart0BaudSetting(uint32_t baudRate, uint32_t fcyc, baudSetting* setting)
+{
+    baudSetting fast;
+    uint32_t normalRate, fastRate, normalError, fastError;
+    normalRate = calcUart0Divisor(baudRate, fcyc, false, setting);
+    fastRate = calcUart0Divisor(baudRate, fcyc, true, &fast);
+    if (fastRate == 0)
+        return normalRate != 0;
+    normalError = (normalRate > baudRate) ? normalRate - baudRate : baudRate - normalRate;
+    fastError = (fastRate > baudRate) ? fastRate - baudRate : baudRate - fastRate;
+    if (normalRate == 0 || fastError < normalError)
+        *setting = fast;
+    return true;
+}
+
+// Waits for everything queued to go out at the old rate, then reprograms the
+// divisor (the LCRH write latches it)
+void applyUart0BaudSetting(const baudSetting* setting)
+{
+    while (dmaBusy || uartTxRingCount(&txRing) != 0 || (UART0_FR_R & UART_FR_BUSY));
+    UART0_CTL_R &= ~UART_CTL_UARTEN;
+    UART0_IBRD_R = setting->ibrd;
+    UART0_FBRD_R = setting->fbrd;
+    UART0_LCRH_R = UART_LCRH_WLEN_8 | UART_LCRH_FEN;
+    if (setting->hse)
+        UART0_CTL_R |= UART_CTL_HSE;
+    else
+        UART0_CTL_R &= ~UART_CTL_HSE;
+    UART0_CTL_R |= UART_CTL_UARTEN;
+    currentBaud = *setting;
+}
+
+void getUart0BaudSetting(baudSetting* setting)
+{
+    *setting = currentBaud;
+}
+
 void setUart0BaudRate(uint32_t baudRate, uint32_t fcyc)
 {
-    uint32_t divisorTimes128 = (fcyc * 8) / baudRate;   // calculate divisor (r) in units of 1/128,
-                                                        // where r = fcyc / 16 * baudRate
-    UART0_IBRD_R = divisorTimes128 >> 7;                 // set integer value to floor(r)
-    UART0_FBRD_R = ((divisorTimes128 + 1)) >> 1 & 63;    // set fractional value to round(fract(r)*64)
+    baudSetting setting;
+    if (findUart0BaudSetting(baudRate, fcyc, &setting))
+        applyUart0BaudSetting(&setting);
 }
 
-// Blocking function that writes a serial character when the UART buffer is not full
+// Queues a character for the TX interrupt. Only waits if the ring is full;
+// with interrupts masked nothing would drain it, so the character is
+// dropped and counted instead.
 void putcUart0(char c)
 {
-    while (UART0_FR_R & UART_FR_TXFF);               // wait if uart0 tx fifo full
-    UART0_DR_R = c;                                  // write character to fifo
+    uint32_t key;
+    if (uartTxRingFree(&txRing) == 0)
+    {
+        key = _disable_interrupts();
+        _restore_interrupts(key);
+        if (key)
+        {
+            uartTxRingPush(&txRing, &c);                 // counts the overflow
+            return;
+        }
+        txStalls++;
+        while (uartTxRingFree(&txRing) == 0);
+    }
+    uartTxRingPush(&txRing, &c);
+    key = _disable_interrupts();
+    fillUart0TxFifo();
+    _restore_interrupts(key);
+}
+
+// Queues a whole block or nothing, for output that would rather drop a
+// packet than wait for room
+bool tryWriteUart0(const void* data, uint16_t size)
+{
+    const char* c = (const char*)data;
+    uint32_t key;
+    uint16_t i;
+    if (uartTxRingFree(&txRing) < size)
+        return false;
+    for (i = 0; i < size; i++)
+        uartTxRingPush(&txRing, &c[i]);
+    key = _disable_interrupts();
+    fillUart0TxFifo();
+    _restore_interrupts(key);
+    return true;
+}
+
+uint32_t getUart0TxFree()
+{
+    return uartTxRingFree(&txRing);
 }
 
-// Blocking function that writes a string when the UART buffer is not full
-void putsUart0(char* str)
+void putsUart0(const char* str)
 {
-    uint8_t i = 0;
+    uint16_t i = 0;
     while (str[i] != '\0')
         putcUart0(str[i++]);
 }
@@ -96,12 +304,34 @@ void putsUart0(char* str)
 // Blocking function that returns with serial data once the buffer is not empty
 char getcUart0()
 {
-    while (UART0_FR_R & UART_FR_RXFE);               // wait if uart0 rx fifo empty
-    return UART0_DR_R & 0xFF;                        // get character from fifo
+    char c;
+    while (!uartRxRingPop(&rxRing, &c));
+    return c;
+}
+
+// Non-blocking, returns false if nothing has been received
+bool tryGetcUart0(char* c)
+{
+    return uartRxRingPop(&rxRing, c);
 }
 
 // Returns the status of the receive buffer
 bool kbhitUart0()
 {
-    return !(UART0_FR_R & UART_FR_RXFE);
+    return uartRxRingCount(&rxRing) != 0;
+}
+
+uint32_t getUart0TxOverflow()
+{
+    return txRing.overflow;
+}
+
+uint32_t getUart0RxOverflow()
+{
+    return rxRing.overflow;
+}
+
+uint32_t getUart0TxStalls()
+{
+    return txStalls;
 }
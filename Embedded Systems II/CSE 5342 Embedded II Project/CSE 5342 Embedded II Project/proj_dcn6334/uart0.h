@@ -21,15 +21,42 @@
 #ifndef UART0_H_
 #define UART0_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef void (*_uartFn)(void);
+
+// Baud rate divisor and the rate it actually gives
+typedef struct _baudSetting
+{
+    uint16_t ibrd;
+    uint8_t fbrd;
+    bool hse;                           // 8x instead of 16x oversampling
+    uint32_t actual;
+} baudSetting;
+
 //-----------------------------------------------------------------------------
 // Subroutines
 //-----------------------------------------------------------------------------
 
 void initUart0();
 void setUart0BaudRate(uint32_t baudRate, uint32_t fcyc);
+bool findUart0BaudSetting(uint32_t baudRate, uint32_t fcyc, baudSetting* setting);
+void applyUart0BaudSetting(const baudSetting* setting);
+void getUart0BaudSetting(baudSetting* setting);
 void putcUart0(char c);
-void putsUart0(char* str);
+void putsUart0(const char* str);
+bool tryWriteUart0(const void* data, uint16_t size);
+uint32_t getUart0TxFree();
 char getcUart0();
+bool tryGetcUart0(char* c);
 bool kbhitUart0();
+void uart0Isr();
+void setUart0RxCallback(_uartFn fn);
+bool writeUart0Dma(const void* data, uint32_t size, _uartFn callback);
+bool isUart0DmaBusy();
+uint32_t getUart0TxOverflow();
+uint32_t getUart0RxOverflow();
+uint32_t getUart0TxStalls();
 
 #endif
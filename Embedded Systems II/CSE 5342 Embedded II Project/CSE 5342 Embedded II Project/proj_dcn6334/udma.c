@@ -0,0 +1,84 @@
+/*
+ * udma.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// uDMA controller, primary control structures only, basic mode
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "tm4c123gh6pm.h"
+#include "udma.h"
+
+// One entry of the channel control table
+typedef struct _dmaControl
+{
+    volatile const void* srcEnd;        // address of the last source item
+    volatile void* dstEnd;
+    volatile uint32_t control;
+    uint32_t unused;
+} dmaControl;
+
+//-----------------------------------------------------------------------------
+// Global variables
+//-----------------------------------------------------------------------------
+
+// The controller needs the table on a 1024-byte boundary
+#pragma DATA_ALIGN(dmaTable, 1024)
+dmaControl dmaTable[32];
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initUdma(void)
+{
+    SYSCTL_RCGCDMA_R |= SYSCTL_RCGCDMA_R0;
+    _delay_cycles(3);
+    UDMA_CFG_R = UDMA_CFG_MASTEN;
+    UDMA_CTLBASE_R = (uint32_t)dmaTable;
+}
+
+// Byte transfer from memory into a peripheral FIFO, in bursts of 4 so the
+// UART FIFO (request at half empty) never overflows
+void startDmaToPeripheral(uint8_t channel, const void* src, volatile void* dst, uint16_t count)
+{
+    uint32_t mask = 1 << channel;
+    dmaTable[channel].srcEnd = (const uint8_t*)src + count - 1;
+    dmaTable[channel].dstEnd = dst;
+    dmaTable[channel].control = UDMA_CHCTL_DSTINC_NONE | UDMA_CHCTL_DSTSIZE_8 |
+                                UDMA_CHCTL_SRCINC_8 | UDMA_CHCTL_SRCSIZE_8 |
+                                UDMA_CHCTL_ARBSIZE_4 |
+                                ((uint32_t)(count - 1) << UDMA_CHCTL_XFERSIZE_S) |
+                                UDMA_CHCTL_XFERMODE_BASIC;
+    UDMA_ALTCLR_R = mask;
+    UDMA_USEBURSTCLR_R = mask;
+    UDMA_REQMASKCLR_R = mask;
+    UDMA_ENASET_R = mask;
+}
+
+// Completion of a peripheral channel is signalled through the interrupt of
+// the peripheral, which has to check it here
+bool isDmaComplete(uint8_t channel)
+{
+    return (UDMA_CHIS_R & (1 << channel)) != 0;
+}
+
+void clearDmaComplete(uint8_t channel)
+{
+    UDMA_CHIS_R = 1 << channel;
+}
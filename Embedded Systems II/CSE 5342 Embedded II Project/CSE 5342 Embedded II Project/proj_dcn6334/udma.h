@@ -0,0 +1,43 @@
+/*
+ * udma.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: dnwae
+ */
+
+//-----------------------------------------------------------------------------
+// Hardware Target
+//-----------------------------------------------------------------------------
+
+// Target uC:       TM4C123GH6PM
+// System Clock:    40 MHz
+
+// Hardware configuration:
+// uDMA controller, primary control structures only, basic mode
+
+//-----------------------------------------------------------------------------
+// Device includes, defines, and assembler directives
+//-----------------------------------------------------------------------------
+
+#ifndef UDMA_H_
+#define UDMA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UDMA_MAX_TRANSFER   1024
+
+// Channels with their default (encoding 0) assignment
+#define UDMA_CH_UART0_RX    8
+#define UDMA_CH_UART0_TX    9
+
+//-----------------------------------------------------------------------------
+// Subroutines
+//-----------------------------------------------------------------------------
+
+void initUdma(void);
+void startDmaToPeripheral(uint8_t channel, const void* src, volatile void* dst, uint16_t count);
+bool isDmaComplete(uint8_t channel);
+void clearDmaComplete(uint8_t channel);
+
+#endif